@@ -0,0 +1,176 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+#elif defined(__linux__)
+	#include <sched.h>
+#endif
+
+namespace
+{
+	double Median(std::vector<double>& Values)
+	{
+		const size_t Middle = Values.size() / 2;
+		std::nth_element(Values.begin(), Values.begin() + Middle, Values.end());
+
+		if (Values.size() % 2)
+			return Values[Middle];
+
+		const double Upper = Values[Middle];
+		return (Upper + *std::max_element(Values.begin(), Values.begin() + Middle)) / 2.0;
+	}
+
+	// benchmark names are plain ascii, only quotes and backslashes need escaping
+	std::string Quoted(const std::string& Value)
+	{
+		std::string Result = "\"";
+
+		for (char Character : Value)
+		{
+			if (Character == '"' || Character == '\\')
+				Result += '\\';
+
+			Result += Character;
+		}
+
+		return Result + "\"";
+	}
+}
+
+namespace Bench
+{
+	Harness::Harness(const Options& Settings)
+		: m_Options(Settings)
+	{
+		m_Options.Repetitions = std::max<size_t>(m_Options.Repetitions, 1);
+
+		if (m_Options.Cpu >= 0 && !PinToCpu(m_Options.Cpu))
+			printf("couldn't pin to cpu %d, running unpinned\n", m_Options.Cpu);
+
+		printf("%-40s %12s %10s %12s\n", "benchmark", "median ns", "mad ns", "min ns");
+	}
+
+
+	bool Harness::Finish()
+	{
+		return m_Options.JsonPath.empty() || WriteJson();
+	}
+
+
+	bool Harness::Selected(const std::string& Name) const
+	{
+		return m_Options.Filter.empty() || Name.find(m_Options.Filter) != std::string::npos;
+	}
+
+
+	void Harness::Record(const std::string& Name, size_t Operations)
+	{
+		const double PerOperation = 1.0 / double(std::max<size_t>(Operations, 1));
+
+		const double Min = *std::min_element(m_Samples.begin(), m_Samples.end());
+		const double Middle = Median(m_Samples);
+
+		for (double& Sample : m_Samples)
+			Sample = std::abs(Sample - Middle);
+
+		const double Mad = Median(m_Samples);
+
+		Result& Entry = m_Results.emplace_back(Result{ Name, Operations, Middle * PerOperation, Mad * PerOperation, Min * PerOperation });
+
+		printf("%-40s %12.3f %10.3f %12.3f\n", Entry.Name.c_str(), Entry.MedianNs, Entry.MadNs, Entry.MinNs);
+	}
+
+
+	bool Harness::PinToCpu(int Cpu)
+	{
+#if defined(_WIN32)
+		if (Cpu >= int(sizeof(DWORD_PTR) * 8))
+			return false;
+
+		return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << Cpu) != 0;
+#elif defined(__linux__)
+		cpu_set_t Set;
+		CPU_ZERO(&Set);
+		CPU_SET(Cpu, &Set);
+
+		return sched_setaffinity(0, sizeof(Set), &Set) == 0;
+#else
+		return false;
+#endif
+	}
+
+
+	bool Harness::WriteJson() const
+	{
+		std::ofstream File(m_Options.JsonPath);
+
+		if (!File)
+		{
+			printf("couldn't write %s\n", m_Options.JsonPath.c_str());
+			return false;
+		}
+
+		File << "{\n\t\"repetitions\": " << m_Options.Repetitions << ",\n\t\"warmup\": " << m_Options.Warmup << ",\n\t\"cpu\": " << m_Options.Cpu << ",\n\t\"benchmarks\": [\n";
+
+		for (size_t i = 0; i < m_Results.size(); i++)
+		{
+			const Result& Entry = m_Results[i];
+
+			File << "\t\t{ \"name\": " << Quoted(Entry.Name)
+				<< ", \"operations\": " << Entry.Operations
+				<< ", \"median_ns\": " << Entry.MedianNs
+				<< ", \"mad_ns\": " << Entry.MadNs
+				<< ", \"min_ns\": " << Entry.MinNs
+				<< (i + 1 < m_Results.size() ? " },\n" : " }\n");
+		}
+
+		File << "\t]\n}\n";
+
+		return bool(File.flush());
+	}
+
+
+	Options ParseOptions(int argc, char* argv[])
+	{
+		Options Settings;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc)
+			{
+				Settings.Repetitions = strtoull(argv[++i], nullptr, 10);
+			}
+
+			else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+			{
+				Settings.Warmup = strtoull(argv[++i], nullptr, 10);
+			}
+
+			else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc)
+			{
+				Settings.Cpu = atoi(argv[++i]);
+			}
+
+			else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+			{
+				Settings.Filter = argv[++i];
+			}
+
+			else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			{
+				Settings.JsonPath = argv[++i];
+			}
+		}
+
+		return Settings;
+	}
+}
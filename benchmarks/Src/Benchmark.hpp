@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+// a small benchmark harness. Every benchmark is warmed up, then timed over
+// a number of repetitions, reported as the median time per operation and
+// the median absolute deviation around it. Medians because a single
+// preempted repetition shouldn't move the number.
+
+namespace Bench
+{
+	// keeps the compiler from optimizing away a result nobody reads
+	template<typename Type>
+	inline void DoNotOptimize(const Type& Value)
+	{
+#if defined(_MSC_VER)
+		static_cast<void>(*reinterpret_cast<const volatile char*>(&Value));
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(Value) : "memory");
+#endif
+	}
+
+	// makes every write before it count as observed
+	inline void ClobberMemory()
+	{
+#if defined(_MSC_VER)
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	struct Options
+	{
+		size_t		Warmup		= 3;
+		size_t		Repetitions	= 21;
+		int			Cpu			= -1;	// pinned to this cpu when not negative
+		std::string	Filter;				// only benchmarks with this in their name
+		std::string	JsonPath;			// results are written here as well when set
+	};
+
+	struct Result
+	{
+		std::string	Name;
+		size_t		Operations;
+		double		MedianNs;	// per operation
+		double		MadNs;		// per operation
+		double		MinNs;		// per operation
+	};
+
+	class Harness
+	{
+
+	public:
+
+		explicit Harness(const Options& Settings);
+
+
+	public:
+
+		// Body does Operations operations per call
+		template<typename Function>
+		void Run(const std::string& Name, size_t Operations, Function&& Body)
+		{
+			if (!Selected(Name))
+				return;
+
+			for (size_t i = 0; i < m_Options.Warmup; i++)
+				Body();
+
+			m_Samples.clear();
+
+			for (size_t i = 0; i < m_Options.Repetitions; i++)
+			{
+				const auto Start = std::chrono::steady_clock::now();
+				Body();
+				const auto End = std::chrono::steady_clock::now();
+
+				m_Samples.push_back(std::chrono::duration<double, std::nano>(End - Start).count());
+			}
+
+			Record(Name, Operations);
+		}
+
+		// writes the json file if one was asked for
+		bool Finish();
+
+
+	private:
+
+		bool Selected(const std::string& Name) const;
+		void Record(const std::string& Name, size_t Operations);
+
+		bool PinToCpu(int Cpu);
+		bool WriteJson() const;
+
+
+	private:
+
+		Options					m_Options;
+		std::vector<double>		m_Samples;
+		std::vector<Result>		m_Results;
+
+	};
+
+	Options ParseOptions(int argc, char* argv[]);
+}
@@ -0,0 +1,113 @@
+#include "Benchmark.hpp"
+#include "Suites.hpp"
+
+#include "Prefabs.hpp"
+#include "Systems/ColliderBoundsSystem.hpp"
+#include "Systems/CollisionSystem.hpp"
+#include "Systems/Groups.hpp"
+
+#include <SDL2/SDL_rect.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t	Count	= 1 << 16;
+	constexpr float		Extent	= 4096.0f;
+	constexpr float		Size	= 100.0f;
+
+	std::vector<TransformComponent> MakeTransforms()
+	{
+		std::minstd_rand Random(11);
+		std::uniform_real_distribution<float> Position(0.0f, Extent);
+
+		std::vector<TransformComponent> Transforms;
+		Transforms.reserve(Count);
+
+		for (size_t i = 0; i < Count; i++)
+			Transforms.emplace_back(Position(Random), Position(Random));
+
+		return Transforms;
+	}
+
+	// one player sized box against every enemy, what a collision tick does
+	void Rects(Bench::Harness& Harness)
+	{
+		const std::vector<TransformComponent> Transforms = MakeTransforms();
+
+		std::vector<SDL_FRect>		Rects;
+		std::vector<ColliderBox>	Boxes;
+
+		for (const TransformComponent& Transform : Transforms)
+		{
+			QuadColliderComponent Collider(Size, Size);
+			Collider.UpdateBounds(Transform);
+
+			const Vector2 Min(Collider.m_Bounds.m_Min);
+
+			Rects.push_back(SDL_FRect{ Min.x, Min.y, Size, Size });
+			Boxes.push_back(Collider.m_Bounds);
+		}
+
+		QuadColliderComponent Player(Size, Size);
+		Player.UpdateBounds(TransformComponent(Extent / 2, Extent / 2));
+
+		const Vector2 PlayerMin(Player.m_Bounds.m_Min);
+		const SDL_FRect PlayerRect{ PlayerMin.x, PlayerMin.y, Size, Size };
+
+		Harness.Run("collision/sdl_has_intersection", Count, [&]()
+		{
+			size_t Hits = 0;
+
+			for (const SDL_FRect& Rect : Rects)
+				Hits += SDL_HasIntersectionF(&PlayerRect, &Rect) == SDL_TRUE;
+
+			Bench::DoNotOptimize(Hits);
+		});
+
+		Harness.Run("collision/inline_aabb", Count, [&]()
+		{
+			size_t Hits = 0;
+
+			for (const ColliderBox& Box : Boxes)
+				Hits += Player.m_Bounds.Overlaps(Box);
+
+			Bench::DoNotOptimize(Hits);
+		});
+	}
+
+	// the real thing, straight out of the owned collider storage
+	void EnemyHits(Bench::Harness& Harness)
+	{
+		const std::vector<TransformComponent> Transforms = MakeTransforms();
+
+		Registry Scene;
+		Groups::Enemies(Scene);
+
+		std::vector<entt::entity> Enemies(Count);
+		Prefabs::Enemy(Size, Size).Spawn(Scene, Enemies.begin(), Enemies.end(), Transforms.begin());
+
+		Systems::UpdateColliderBounds(Scene);
+
+		QuadColliderComponent Player(Size, Size);
+		Player.UpdateBounds(TransformComponent(Extent / 2, Extent / 2));
+
+		std::vector<entt::entity> Hits;
+		Hits.reserve(Count);
+
+		Harness.Run("collision/enemy_hits", Count, [&]()
+		{
+			Hits.clear();
+			Systems::CollectEnemyHits(Scene, Player.m_Bounds, Hits);
+
+			Bench::DoNotOptimize(Hits.data());
+		});
+	}
+}
+
+void RunCollisionBenchmarks(Bench::Harness& Harness)
+{
+	Rects(Harness);
+	EnemyHits(Harness);
+}
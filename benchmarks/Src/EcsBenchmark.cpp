@@ -0,0 +1,150 @@
+#include "Benchmark.hpp"
+#include "Suites.hpp"
+
+#include "Components/AccelerationComponent.hpp"
+#include "Components/QuadColliderComponent.hpp"
+#include "Components/QuadComponent.hpp"
+#include "Components/Tags.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/VelocityComponent.hpp"
+#include "Prefabs.hpp"
+#include "Systems/Groups.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Size
+	{
+		size_t		Count;
+		const char*	Suffix;
+	};
+
+	// iteration at a size that fits in cache, one that doesn't and one past any real level
+	constexpr Size Sizes[] = { { 1000, "1k" }, { 100000, "100k" }, { 1000000, "1m" } };
+
+	constexpr size_t CreateCount = 1 << 17;
+
+	// every other entity is static so the views have something to skip
+	template<bool Grouped>
+	void Populate(Registry& Scene, size_t Count)
+	{
+		if constexpr (Grouped)
+			Groups::Enemies(Scene);
+
+		std::minstd_rand Random(5);
+		std::uniform_real_distribution<float> Position(0.0f, 4096.0f);
+
+		for (size_t i = 0; i < Count; i++)
+		{
+			const entt::entity Entity = Scene.create();
+
+			Scene.emplace<TransformComponent>(Entity, Position(Random), Position(Random));
+			Scene.emplace<QuadComponent>(Entity, 100.0f, 100.0f);
+			Scene.emplace<QuadColliderComponent>(Entity, 100.0f, 100.0f);
+
+			if (i % 2)
+				Scene.emplace<Tags::Static>(Entity);
+			else
+				Scene.emplace<Tags::Enemy>(Entity);
+		}
+	}
+
+	template<typename Iterable>
+	void Iterate(Bench::Harness& Harness, const std::string& Name, Iterable&& Entities, size_t Operations)
+	{
+		Harness.Run(Name, Operations, [&]()
+		{
+			for (auto [Entity, Transform, Quad, Collider] : Entities.each())
+				Collider.UpdateBounds(Transform);
+
+			Bench::ClobberMemory();
+		});
+	}
+
+	// the storages picked at run time, as a script or an editor would, and
+	// every component fetched per entity instead of unpacked in step
+	void IterateRuntime(Bench::Harness& Harness, const std::string& Name, Registry& Scene, size_t Operations)
+	{
+		auto& Transforms	= Scene.storage<TransformComponent>();
+		auto& Quads			= Scene.storage<QuadComponent>();
+		auto& Colliders		= Scene.storage<QuadColliderComponent>();
+		auto& Enemies		= Scene.storage<Tags::Enemy>();
+
+		entt::basic_runtime_view<Registry::common_type> Entities;
+		Entities.iterate(Transforms).iterate(Quads).iterate(Colliders).iterate(Enemies);
+
+		Harness.Run(Name, Operations, [&]()
+		{
+			for (entt::entity Entity : Entities)
+				Colliders.get(Entity).UpdateBounds(Transforms.get(Entity));
+
+			Bench::ClobberMemory();
+		});
+	}
+
+	void Iteration(Bench::Harness& Harness, const Size& Each)
+	{
+		const std::string Suffix = std::string("/") + Each.Suffix;
+
+		{
+			Registry Scene;
+			Populate<false>(Scene, Each.Count);
+
+			Iterate(Harness, "ecs/view/transform_quad_collider" + Suffix, Scene.view<TransformComponent, QuadComponent, QuadColliderComponent>(), Each.Count);
+			Iterate(Harness, "ecs/view/enemies" + Suffix, Scene.view<TransformComponent, QuadComponent, QuadColliderComponent, Tags::Enemy>(), Each.Count / 2);
+			IterateRuntime(Harness, "ecs/runtime_view/enemies" + Suffix, Scene, Each.Count / 2);
+		}
+
+		{
+			Registry Scene;
+			Populate<true>(Scene, Each.Count);
+
+			Iterate(Harness, "ecs/group/enemies" + Suffix, Groups::Enemies(Scene), Each.Count / 2);
+		}
+	}
+
+	void CreateDestroy(Bench::Harness& Harness)
+	{
+		std::vector<TransformComponent> Transforms(CreateCount, TransformComponent(0.0f, 0.0f));
+		std::vector<entt::entity> Entities(CreateCount);
+
+		Registry Scene;
+		Groups::Enemies(Scene);
+
+		Harness.Run("ecs/create_destroy/single", CreateCount, [&]()
+		{
+			for (entt::entity& Entity : Entities)
+			{
+				Entity = Scene.create();
+
+				// everything Prefabs::Enemy spawns, so the two cases do the same work
+				Scene.emplace<Tags::Enemy>(Entity);
+				Scene.emplace<TransformComponent>(Entity, 0.0f, 0.0f);
+				Scene.emplace<QuadComponent>(Entity, 100.0f, 100.0f);
+				Scene.emplace<QuadColliderComponent>(Entity, 100.0f, 100.0f);
+				Scene.emplace<VelocityComponent>(Entity);
+				Scene.emplace<AccelerationComponent>(Entity);
+			}
+
+			for (entt::entity Entity : Entities)
+				Scene.destroy(Entity);
+		});
+
+		Harness.Run("ecs/create_destroy/bulk", CreateCount, [&]()
+		{
+			Prefabs::Enemy(100, 100).Spawn(Scene, Entities.begin(), Entities.end(), Transforms.begin());
+			Scene.destroy(Entities.begin(), Entities.end());
+		});
+	}
+}
+
+void RunEcsBenchmarks(Bench::Harness& Harness)
+{
+	for (const Size& Each : Sizes)
+		Iteration(Harness, Each);
+
+	CreateDestroy(Harness);
+}
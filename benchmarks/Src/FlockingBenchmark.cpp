@@ -0,0 +1,153 @@
+#include "Benchmark.hpp"
+#include "Suites.hpp"
+
+#include "JobSystem.hpp"
+#include "Prefabs.hpp"
+#include "Systems/FlowField.hpp"
+#include "Systems/Flocking.hpp"
+#include "Systems/Groups.hpp"
+#include "Systems/LodScheduler.hpp"
+#include "Systems/NavigationGrid.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t	Count	= 100000;
+	constexpr float		Extent	= 8192.0f;	// about 1.5 agents per flocking cell
+
+	// flow field cells across the extent, and walls scattered over them
+	constexpr int32_t	FieldCells	= 256;
+	constexpr float		FieldCell	= Extent / FieldCells;
+	constexpr size_t	Walls		= 4096;
+
+	void PlaceWalls(Registry& Scene)
+	{
+		std::minstd_rand Random(19);
+		std::uniform_int_distribution<int32_t> Cell(0, FieldCells - 1);
+
+		std::vector<TransformComponent> Transforms;
+
+		for (size_t i = 0; i < Walls; i++)
+			Transforms.emplace_back(Cell(Random) * FieldCell, Cell(Random) * FieldCell);
+
+		std::vector<entt::entity> Spawned(Walls);
+		Prefabs::Wall(FieldCell).Spawn(Scene, Spawned.begin(), Spawned.end(), Transforms.begin());
+	}
+
+	void Populate(Registry& Scene)
+	{
+		std::minstd_rand Random(17);
+		std::uniform_real_distribution<float> Position(0.0f, Extent);
+		std::uniform_real_distribution<float> Drift(-60.0f, 60.0f);
+
+		std::vector<TransformComponent>	Transforms;
+		std::vector<VelocityComponent>	Velocities;
+
+		for (size_t i = 0; i < Count; i++)
+		{
+			Transforms.emplace_back(Position(Random), Position(Random));
+			Velocities.emplace_back(Drift(Random), Drift(Random));
+		}
+
+		Groups::Enemies(Scene);
+		Groups::Movers(Scene);
+
+		std::vector<entt::entity> Enemies(Count);
+		Prefabs::Enemy(100.0f, 100.0f).Spawn(Scene, Enemies.begin(), Enemies.end(), Transforms.begin(), Velocities.begin());
+	}
+
+	// one flocking tick, grid rebuild and steering, single threaded and on every core
+	void Update(Bench::Harness& Harness, const char* Name, uint32_t Workers)
+	{
+		Registry Scene;
+		Populate(Scene);
+
+		// an empty grid, the field points every agent straight at the goal.
+		// A scheduler that was never begun keeps everyone at full rate
+		JobSystem		Jobs(Workers);
+		NavigationGrid	Grid;
+		FlowField		Field;
+		LodScheduler	Lod;
+		Flocking		Flock;
+
+		Field.Update(Grid, Jobs, SimVector2(Vector2(Extent / 2, Extent / 2)));
+
+		Harness.Run(Name, Count, [&]()
+		{
+			Flock.Update(Scene, Jobs, Field, Lod, {});
+
+			Bench::ClobberMemory();
+		});
+	}
+
+	// the same tick with the player in the middle and a screen around it,
+	// the far agents steered every few ticks
+	void UpdateLod(Bench::Harness& Harness)
+	{
+		Registry Scene;
+		Populate(Scene);
+
+		JobSystem		Jobs(0);
+		NavigationGrid	Grid;
+		FlowField		Field;
+		LodScheduler	Lod;
+		Flocking		Flock;
+
+		const SimVector2	Focus(Vector2(Extent / 2, Extent / 2));
+		const Vector2		HalfView(640.0f, 360.0f);
+
+		Field.Update(Grid, Jobs, Focus);
+
+		uint64_t Tick = 0;
+
+		Harness.Run("flocking/update_lod", Count, [&]()
+		{
+			Lod.Begin(Tick++, Focus, Vector2(Focus) - HalfView, Vector2(Focus) + HalfView, {});
+			Flock.Update(Scene, Jobs, Field, Lod, {});
+
+			Bench::ClobberMemory();
+		});
+	}
+
+	// rasterizing the walls, and integrating the field when the goal moves to another cell
+	void Navigation(Bench::Harness& Harness)
+	{
+		Registry Scene;
+		PlaceWalls(Scene);
+
+		JobSystem		Jobs(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+		NavigationGrid	Grid;
+		FlowField		Field;
+
+		Grid.Resize(Vector2(0, 0), FieldCells, FieldCells, FieldCell);
+
+		const SimVector2 Goals[2] = { SimVector2(Vector2(Extent / 2, Extent / 2)), SimVector2(Vector2(Extent / 4, Extent / 4)) };
+		size_t Next = 0;
+
+		Harness.Run("navigation/rasterize", FieldCells * FieldCells, [&]()
+		{
+			Grid.Invalidate();
+			Grid.Update(Scene, Jobs);
+
+			Bench::ClobberMemory();
+		});
+
+		Harness.Run("flowfield/goal_moved", FieldCells * FieldCells, [&]()
+		{
+			Field.Update(Grid, Jobs, Goals[Next++ % 2]);
+
+			Bench::ClobberMemory();
+		});
+	}
+}
+
+void RunFlockingBenchmarks(Bench::Harness& Harness)
+{
+	Update(Harness, "flocking/update_1_thread", 0);
+	Update(Harness, "flocking/update_all_threads", std::max(std::thread::hardware_concurrency(), 1u) - 1);
+	UpdateLod(Harness);
+	Navigation(Harness);
+}
@@ -0,0 +1,65 @@
+#include "LegacyVector2.hpp"
+
+#include <math.h>
+
+LegacyVector2::LegacyVector2(float X, float Y)
+	: x(X)
+	, y(Y)
+{
+
+}
+
+
+float LegacyVector2::Magnitude() const
+{
+	return sqrt( pow(x, 2) + pow(y, 2) );
+}
+
+
+LegacyVector2 LegacyVector2::Normalize() const
+{
+	LegacyVector2 This = *this;
+
+	return This / Magnitude();
+}
+
+
+float LegacyVector2::Dot(const LegacyVector2& rhs) const
+{
+	return (x * rhs.x) + (y * rhs.y);
+}
+
+
+LegacyVector2 LegacyVector2::operator / (float scalar)
+{
+	if (scalar)	// non-zero check
+	{
+		return LegacyVector2(x / scalar, y / scalar);
+	}
+
+	return *this;
+}
+
+
+LegacyVector2 LegacyVector2::operator * (float scalar)
+{
+	return LegacyVector2(x * scalar, y * scalar);
+}
+
+
+float LegacyVector2::operator * (const LegacyVector2& rhs)
+{
+	return Dot(rhs);
+}
+
+
+LegacyVector2 LegacyVector2::operator + (const LegacyVector2& rhs)
+{
+	return LegacyVector2(x + rhs.x, y + rhs.y);
+}
+
+
+LegacyVector2 LegacyVector2::operator - (const LegacyVector2& rhs)
+{
+	return LegacyVector2(x - rhs.x, y - rhs.y);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// Vector2 as it was before it went header only, out of line operators and
+// double precision pow/sqrt. Kept as the baseline the Vector2 benchmarks
+// compare against.
+
+struct LegacyVector2
+{
+
+public:
+
+	float	x;
+	float	y;
+
+	LegacyVector2(float X = 0, float Y = 0);
+	~LegacyVector2() = default;
+
+
+public:
+	
+	LegacyVector2	Normalize()						const;
+	float			Magnitude()						const;
+	float			Dot(const LegacyVector2& rhs)	const;
+
+
+public:
+
+	LegacyVector2 operator / (float scalar);
+	LegacyVector2 operator * (float scalar);
+	LegacyVector2 operator + (const LegacyVector2& rhs);
+	LegacyVector2 operator - (const LegacyVector2& rhs);
+	float	operator * (const LegacyVector2& rhs);
+
+};
@@ -0,0 +1,92 @@
+#include "Benchmark.hpp"
+#include "Suites.hpp"
+
+#include "Prefabs.hpp"
+#include "Systems/Groups.hpp"
+#include "Systems/MovementSystem.hpp"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t	Count	= 100000;
+	constexpr float		Extent	= 4096.0f;
+	constexpr float		Dt		= 1.0f / 60.0f;
+
+	constexpr Systems::MovementSettings Settings{ 0.5f, 400.0f };
+
+	// enemies laid out like the game's, with a drift and a steady pull each
+	void Populate(Registry& Scene)
+	{
+		std::minstd_rand Random(13);
+		std::uniform_real_distribution<float> Position(0.0f, Extent);
+		std::uniform_real_distribution<float> Drift(-60.0f, 60.0f);
+
+		std::vector<TransformComponent>	Transforms;
+		std::vector<VelocityComponent>	Velocities;
+
+		for (size_t i = 0; i < Count; i++)
+		{
+			Transforms.emplace_back(Position(Random), Position(Random));
+			Velocities.emplace_back(Drift(Random), Drift(Random));
+		}
+
+		Groups::Enemies(Scene);
+		Groups::Movers(Scene);
+
+		std::vector<entt::entity> Enemies(Count);
+		Prefabs::Enemy(100.0f, 100.0f).Spawn(Scene, Enemies.begin(), Enemies.end(), Transforms.begin(), Velocities.begin());
+
+		for (auto [Entity, Acceleration] : Scene.view<AccelerationComponent>().each())
+			Acceleration.m_Acceleration = SimVector2(Vector2(Drift(Random), Drift(Random)));
+	}
+
+	// what the integration would be as a plain view loop, one entity at a time
+	void Scalar(Bench::Harness& Harness)
+	{
+		Registry Scene;
+		Populate(Scene);
+
+		const SimScalar Step(Dt);
+		const SimScalar Keep(1.0f - Settings.Damping * Dt);
+		const SimScalar MaxSpeed(Settings.MaxSpeed);
+
+		Harness.Run("movement/view_scalar", Count, [&]()
+		{
+			for (auto [Entity, Velocity, Acceleration, Transform] : Scene.view<VelocityComponent, AccelerationComponent, TransformComponent>().each())
+			{
+				Velocity.m_Velocity = (Velocity.m_Velocity + Acceleration.m_Acceleration * Step) * Keep;
+
+				const SimScalar Speed = Velocity.m_Velocity.Magnitude();
+
+				if (Speed > MaxSpeed)
+					Velocity.m_Velocity = Velocity.m_Velocity * (MaxSpeed / Speed);
+
+				Transform.m_Position	+= Velocity.m_Velocity * Step;
+				Transform.m_Dirty		= true;
+			}
+
+			Bench::ClobberMemory();
+		});
+	}
+
+	void Integrate(Bench::Harness& Harness)
+	{
+		Registry Scene;
+		Populate(Scene);
+
+		Harness.Run("movement/integrate", Count, [&]()
+		{
+			Systems::IntegrateMovement(Scene, Dt, Settings);
+
+			Bench::ClobberMemory();
+		});
+	}
+}
+
+void RunMovementBenchmarks(Bench::Harness& Harness)
+{
+	Scalar(Harness);
+	Integrate(Harness);
+}
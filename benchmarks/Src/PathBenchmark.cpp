@@ -0,0 +1,99 @@
+#include "Benchmark.hpp"
+#include "Suites.hpp"
+
+#include "JobSystem.hpp"
+#include "Prefabs.hpp"
+#include "Systems/NavigationGrid.hpp"
+#include "Systems/PathGraph.hpp"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr int32_t	Cells		= 256;
+	constexpr float		CellSize	= 32.0f;
+	constexpr size_t	Walls		= 4096;
+	constexpr size_t	Queries		= 256;
+
+	// scattered single cells and a few long walls with gaps, so paths have to go around
+	void PlaceWalls(Registry& Scene)
+	{
+		std::minstd_rand Random(23);
+		std::uniform_int_distribution<int32_t> Cell(0, Cells - 1);
+
+		std::vector<TransformComponent> Transforms;
+
+		for (size_t i = 0; i < Walls; i++)
+			Transforms.emplace_back(Cell(Random) * CellSize, Cell(Random) * CellSize);
+
+		for (int32_t x = 32; x < Cells; x += 32)
+		{
+			for (int32_t y = 0; y < Cells; y++)
+			{
+				if (y % 64 > 4)
+					Transforms.emplace_back(x * CellSize, y * CellSize);
+			}
+		}
+
+		std::vector<entt::entity> Spawned(Transforms.size());
+		Prefabs::Wall(CellSize).Spawn(Scene, Spawned.begin(), Spawned.end(), Transforms.begin());
+	}
+}
+
+void RunPathBenchmarks(Bench::Harness& Harness)
+{
+	Registry Scene;
+	PlaceWalls(Scene);
+
+	JobSystem		Jobs(0);
+	NavigationGrid	Grid;
+	PathGraph		Graph;
+
+	Grid.Resize(Vector2(0, 0), Cells, Cells, CellSize);
+	Grid.Update(Scene, Jobs);
+
+	Harness.Run("pathgraph/build", size_t(Cells) * Cells, [&]()
+	{
+		Graph.Build(Grid);
+
+		Bench::ClobberMemory();
+	});
+
+	// the same queries every repetition, open cells only
+	std::minstd_rand Random(29);
+	std::uniform_int_distribution<int32_t> Cell(0, Cells - 1);
+
+	std::vector<SimVector2> Ends;
+
+	while (Ends.size() < Queries * 2)
+	{
+		const int32_t x = Cell(Random);
+		const int32_t y = Cell(Random);
+
+		if (!Grid.Blocked(x, y))
+			Ends.emplace_back(Grid.CentreOf(x, y));
+	}
+
+	PathGraph::SearchSpace	Space;
+	PathGraph::Route		Searched;
+	std::vector<SimVector2>	Waypoints;
+
+	auto Query = [&]()
+	{
+		for (size_t i = 0; i < Queries; i++)
+		{
+			Bench::DoNotOptimize(Graph.FindPath(Space, Ends[i * 2], Ends[i * 2 + 1], Waypoints, Searched));
+			Graph.Learn(Searched);
+		}
+	};
+
+	// every cluster pair searched from scratch, then every route out of the cache
+	Harness.Run("pathgraph/query_uncached", Queries, [&]()
+	{
+		Graph.ClearCache();
+		Query();
+	});
+
+	Harness.Run("pathgraph/query_cached", Queries, Query);
+}
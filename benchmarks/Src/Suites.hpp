@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Benchmark.hpp"
+
+void RunVector2Benchmarks(Bench::Harness& Harness);
+void RunCollisionBenchmarks(Bench::Harness& Harness);
+void RunEcsBenchmarks(Bench::Harness& Harness);
+void RunMovementBenchmarks(Bench::Harness& Harness);
+void RunFlockingBenchmarks(Bench::Harness& Harness);
+void RunPathBenchmarks(Bench::Harness& Harness);
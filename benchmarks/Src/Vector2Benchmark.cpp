@@ -0,0 +1,139 @@
+#include "Benchmark.hpp"
+#include "LegacyVector2.hpp"
+#include "Suites.hpp"
+
+#include "Simd.hpp"
+#include "Vector2.hpp"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Count = 1 << 16;
+
+	// the same vectors for both implementations, a few of them zero
+	template<typename Type>
+	std::vector<Type> MakeVectors()
+	{
+		std::minstd_rand Random(7);
+		std::uniform_real_distribution<float> Component(-100.0f, 100.0f);
+
+		std::vector<Type> Vectors;
+		Vectors.reserve(Count);
+
+		for (size_t i = 0; i < Count; i++)
+			Vectors.emplace_back(i % 64 ? Component(Random) : 0.0f, i % 64 ? Component(Random) : 0.0f);
+
+		return Vectors;
+	}
+
+	template<typename Type>
+	void Magnitude(Bench::Harness& Harness, const char* Name)
+	{
+		std::vector<Type> Vectors = MakeVectors<Type>();
+
+		Harness.Run(Name, Count, [&]()
+		{
+			float Sum = 0.0f;
+
+			for (const Type& Vector : Vectors)
+				Sum += Vector.Magnitude();
+
+			Bench::DoNotOptimize(Sum);
+		});
+	}
+
+	template<typename Type>
+	void Normalize(Bench::Harness& Harness, const char* Name)
+	{
+		std::vector<Type> Vectors = MakeVectors<Type>();
+		std::vector<Type> Results(Count);
+
+		Harness.Run(Name, Count, [&]()
+		{
+			for (size_t i = 0; i < Count; i++)
+				Results[i] = Vectors[i].Normalize();
+
+			Bench::DoNotOptimize(Results.data());
+		});
+	}
+
+	// position += direction * speed, what moving anything comes down to
+	template<typename Type>
+	void Translate(Bench::Harness& Harness, const char* Name)
+	{
+		std::vector<Type> Positions		= MakeVectors<Type>();
+		std::vector<Type> Directions	= MakeVectors<Type>();
+
+		Harness.Run(Name, Count, [&]()
+		{
+			for (size_t i = 0; i < Count; i++)
+				Positions[i] = Positions[i] + Directions[i] * 0.5f;
+
+			Bench::DoNotOptimize(Positions.data());
+		});
+	}
+
+	// the same on separate x and y arrays, eight at a time
+	void TranslateBatch(Bench::Harness& Harness, const char* Name)
+	{
+		std::vector<Vector2> Positions	= MakeVectors<Vector2>();
+		std::vector<Vector2> Directions	= MakeVectors<Vector2>();
+
+		std::vector<float> X(Count), Y(Count), Dx(Count), Dy(Count);
+
+		for (size_t i = 0; i < Count; i++)
+		{
+			X[i]	= Positions[i].x;
+			Y[i]	= Positions[i].y;
+			Dx[i]	= Directions[i].x;
+			Dy[i]	= Directions[i].y;
+		}
+
+		Harness.Run(Name, Count, [&]()
+		{
+			Simd::MultiplyAdd(X.data(), Y.data(), Dx.data(), Dy.data(), 0.5f, Count);
+
+			Bench::DoNotOptimize(X.data());
+			Bench::ClobberMemory();
+		});
+	}
+
+	template<typename Type>
+	void Dot(Bench::Harness& Harness, const char* Name)
+	{
+		std::vector<Type> Lhs = MakeVectors<Type>();
+		std::vector<Type> Rhs = MakeVectors<Type>();
+
+		Harness.Run(Name, Count, [&]()
+		{
+			float Sum = 0.0f;
+
+			for (size_t i = 0; i < Count; i++)
+				Sum += Lhs[i].Dot(Rhs[i]);
+
+			Bench::DoNotOptimize(Sum);
+		});
+	}
+
+	static_assert(Vector2(3.0f, 4.0f).Magnitude() == 5.0f, "constexpr Magnitude");
+	static_assert(Vector2(0.0f, 2.0f).Normalize() == Vector2(0.0f, 1.0f), "constexpr Normalize");
+	static_assert(Vector2().NormalizeSafe() == Vector2(), "zero stays zero");
+}
+
+void RunVector2Benchmarks(Bench::Harness& Harness)
+{
+	Magnitude<LegacyVector2>(Harness, "vector2/magnitude/legacy");
+	Magnitude<Vector2>(Harness, "vector2/magnitude");
+
+	Normalize<LegacyVector2>(Harness, "vector2/normalize/legacy");
+	Normalize<Vector2>(Harness, "vector2/normalize");
+
+	Translate<LegacyVector2>(Harness, "vector2/translate/legacy");
+	Translate<Vector2>(Harness, "vector2/translate");
+	TranslateBatch(Harness, "vector2/translate/soa_x8");
+
+	Dot<LegacyVector2>(Harness, "vector2/dot/legacy");
+	Dot<Vector2>(Harness, "vector2/dot");
+}
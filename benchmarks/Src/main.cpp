@@ -0,0 +1,17 @@
+#include "Suites.hpp"
+
+// benchmarks [--filter TEXT] [--repetitions N] [--warmup N] [--cpu N] [--json FILE]
+
+int main(int argc, char* argv[])
+{
+	Bench::Harness Harness(Bench::ParseOptions(argc, argv));
+
+	RunVector2Benchmarks(Harness);
+	RunCollisionBenchmarks(Harness);
+	RunEcsBenchmarks(Harness);
+	RunMovementBenchmarks(Harness);
+	RunFlockingBenchmarks(Harness);
+	RunPathBenchmarks(Harness);
+
+	return Harness.Finish() ? 0 : 1;
+}
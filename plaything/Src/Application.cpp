@@ -1,16 +1,46 @@
 #include "Application.hpp"
 
-Application::Application()
+#include "Memory/PageArena.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+Application::Application(int argc, char* argv[])
 	: m_Window(nullptr)
 	, m_Renderer(nullptr)
+	, m_WaveRequested(false)
+	, m_ScatterRequested(false)
+	, m_Tick(0)
+	, m_RewindRequested(false)
+	, m_SortedEnemies(0)
+	, m_StorageReportRequested(false)
 	
 	, m_Title("plaything")
 	, m_Width(1280)
 	, m_Height(720)
 
 	, m_Running(true)
-{
+	, m_SoftwareRendering(false)
+	, m_IncrementalRedraw(false)
+	, m_Headless(false)
+
+	, m_FrameIndex(0)
+	, m_FrameLimit(0)
+	, m_ExitCode(0)
 
+	, m_FrameTexture(nullptr)
+	, m_BackBuffer(nullptr)
+
+	, m_CaptureFormat(CaptureFormat::PNG)
+	, m_ScreenshotRequested(false)
+
+	, m_ShowOverlay(false)
+	, m_OverlayFrames(0)
+	, m_OverlayFrameMs(0.0)
+	, m_OverlayTickMs(0.0)
+	, m_OverlayShown{ -1, -1, -1, -1, -1, -1, -1 }
+{
+	ParseArguments(argc, argv);
 }
 
 int Application::OnExecute()
@@ -20,6 +50,9 @@ int Application::OnExecute()
 	
 	SDL_Event Event{};
 
+	const double TicksToMs = 1000.0 / double(SDL_GetPerformanceFrequency());
+	uint64_t FrameStart = SDL_GetPerformanceCounter();
+
 	while (m_Running)
 	{
 		while (SDL_PollEvent(&Event))
@@ -27,11 +60,100 @@ int Application::OnExecute()
 			OnEvent(&Event);
 		}
 
+		uint64_t TickStart = SDL_GetPerformanceCounter();
 		OnLoop();
+		m_Stats.TickMs = double(SDL_GetPerformanceCounter() - TickStart) * TicksToMs;
+
 		OnRender();
+
+		uint64_t FrameEnd = SDL_GetPerformanceCounter();
+		m_Stats.FrameMs = double(FrameEnd - FrameStart) * TicksToMs;
+		FrameStart = FrameEnd;
+
+		if (m_FrameLimit && ++m_FrameIndex >= m_FrameLimit)
+			m_Running = false;
 	}
 
 	OnCleanup();
 
-	return 0;
+	return m_ExitCode;
+}
+
+void Application::ParseArguments(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		// rasterize on the cpu across all cores, only the final image goes through SDL
+		if (strcmp(argv[i], "--software") == 0)
+		{
+			m_SoftwareRendering = true;
+		}
+
+		// keep a persistent back buffer and only redraw what changed
+		else if (strcmp(argv[i], "--incremental") == 0)
+		{
+			m_IncrementalRedraw = true;
+		}
+
+		// frame and simulation timings on screen, F3 toggles it
+		else if (strcmp(argv[i], "--hud") == 0)
+		{
+			m_ShowOverlay = true;
+		}
+
+		// component storages on transparent huge pages (linux)
+		else if (strcmp(argv[i], "--huge-pages") == 0)
+		{
+			Memory::PageArena::Get().EnableHugePages(true);
+		}
+
+		// build the scene from a snapshot instead of code
+		else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc)
+		{
+			m_LoadPath = argv[++i];
+		}
+
+		// snapshot the scene on exit
+		else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc)
+		{
+			m_SavePath = argv[++i];
+		}
+
+		// stream enemies in chunks from a directory, chunks never visited are generated
+		else if (strcmp(argv[i], "--world") == 0 && i + 1 < argc)
+		{
+			m_WorldDirectory = argv[++i];
+		}
+
+		// hidden window, no vsync, quits after --frames
+		else if (strcmp(argv[i], "--headless") == 0)
+		{
+			m_Headless = true;
+		}
+
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+		{
+			m_FrameLimit = strtoull(argv[++i], nullptr, 10);
+		}
+
+		// dump every frame into a directory
+		else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+		{
+			m_CaptureDirectory = argv[++i];
+		}
+
+		else if (strcmp(argv[i], "--capture-raw") == 0)
+		{
+			m_CaptureFormat = CaptureFormat::Raw;
+		}
+
+		// compare the last frame against a golden image, written if it doesn't exist yet
+		else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+		{
+			m_GoldenPath = argv[++i];
+		}
+	}
+
+	if (!m_GoldenPath.empty() && m_FrameLimit == 0)
+		m_FrameLimit = GoldenFrames;
 }
\ No newline at end of file
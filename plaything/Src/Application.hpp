@@ -3,17 +3,84 @@
 #include <SDL2/SDL.h>
 #include <entt/entt.hpp>
 
+#include "Components/HierarchyComponent.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/VelocityComponent.hpp"
+#include "FrameStats.hpp"
+#include "JobSystem.hpp"
+#include "LevelMetadata.hpp"
+#include "Memory/StorageStats.hpp"
+#include "Registry.hpp"
+#include "Renderer/DamageTracker.hpp"
+#include "Renderer/DebugOverlay.hpp"
+#include "Renderer/FrameCapture.hpp"
+#include "Renderer/RenderCommand.hpp"
+#include "Renderer/SDLRenderBackend.hpp"
+#include "Renderer/SoftwareRasterizer.hpp"
+#include "Renderer/StaticLayer.hpp"
+#include "Serialization/RollbackBuffer.hpp"
+#include "Systems/FlowField.hpp"
+#include "Systems/Flocking.hpp"
+#include "Systems/LodScheduler.hpp"
+#include "Systems/NavigationGrid.hpp"
+#include "Systems/PathPlanner.hpp"
+#include "Systems/TransformHierarchy.hpp"
+#include "World/WorldStreamer.hpp"
+
+#include <random>
 #include <string>
+#include <vector>
 
 constexpr uint32_t TileW = 100;
 constexpr uint32_t TileH = 100;
 
+constexpr uint32_t FloorTile	= 32;
+constexpr uint32_t WallTile		= 40;
+
+// enemies alive at once the storages are reserved for
+constexpr uint32_t MaxEnemies	= 4096;
+
+// enemies spawned per wave, F5 sends one
+constexpr uint32_t WaveSize		= 256;
+
+// seconds the simulation advances per tick
+constexpr float TickSeconds	= 1.0f / 60.0f;
+
+// fraction of an enemy's velocity lost per second, and how fast it can go
+constexpr float EnemyDamping	= 0.5f;
+constexpr float EnemyMaxSpeed	= 400.0f;
+
+// cells of the navigation grid enemies find their way on, a wall tile each
+constexpr float NavigationCell	= float(WallTile);
+
+// threads searching paths off the frame, F6 scatters the enemies along them
+constexpr uint32_t PathWorkers	= 2;
+
+// fastest drift a wave enemy spawns with
+constexpr float WaveSpeed		= 60.0f;
+
+// ticks between spatial sorts of the enemy storages
+constexpr uint64_t SpatialSortInterval	= 8;
+
+// ticks between storage memory reports
+constexpr uint64_t StorageStatsInterval	= 120;
+
+// ticks of state kept for rewinding, and how far F7 rewinds
+constexpr size_t RollbackTicks	= 60;
+constexpr uint64_t RewindTicks	= 30;
+
+// frames a golden image run renders when --frames isn't given
+constexpr uint64_t GoldenFrames	= 60;
+
+// frames the overlay averages timings over
+constexpr uint32_t OverlayInterval	= 30;
+
 class Application
 {
 
 public:
 
-	Application();
+	Application(int argc, char* argv[]);
 	~Application() = default;
 
 	int OnExecute();
@@ -30,21 +97,106 @@ private:
 
 private:
 
+	void ParseArguments(int argc, char* argv[]);
 	void InitResource();
+	void SpawnWave();
+	void Scatter();
+	void SpawnEnemies(const std::vector<TransformComponent>& Transforms, const std::vector<VelocityComponent>& Velocities);
+	void StreamWorld();
+	void AttachHealthBars();
+	void Rewind();
+	void UpdateStorageStats();
 	void HandlePlayerInput(SDL_Event* Event);
-	void PlayerMovement(class Vector2 Direction);
+	void PlayerMovement(Vector2 Direction);
+	void RenderSoftware(const RenderCommandList& Commands);
+	void RenderIncremental(const RenderCommandList& Commands);
+	void PresentFrame();
+	void CaptureFrame(bool Dump, bool Golden);
+	void UpdateOverlay();
 
 
 private:
 
 	SDL_Window*		m_Window;
 	SDL_Renderer*	m_Renderer;
-	entt::registry	m_Scene;
+	Registry	m_Scene;
+	LevelMetadata	m_Level;
+
+	// scene snapshots, loaded instead of building the level and saved on exit
+	std::string		m_LoadPath;
+	std::string		m_SavePath;
+
+	std::vector<entt::entity>	m_Hits;
+
+	// scratch for bulk spawns, kept around so waves don't allocate
+	std::vector<entt::entity>		m_Spawned;
+	std::vector<TransformComponent>	m_SpawnTransforms;
+	std::vector<VelocityComponent>	m_SpawnVelocities;
+	std::vector<HierarchyComponent>	m_SpawnAttachments;
+	std::minstd_rand				m_Random;
+	bool							m_WaveRequested;
+	bool							m_ScatterRequested;
+
+	TransformHierarchy	m_Hierarchy;
+	NavigationGrid		m_Navigation;
+	FlowField			m_FlowField;
+	PathPlanner			m_Paths;
+	LodScheduler		m_Lod;
+	Flocking			m_Flocking;
+
+	// enemies streamed in chunks around the player, off unless --world is given
+	WorldStreamer	m_World;
+	std::string		m_WorldDirectory;
+
+	RollbackBuffer	m_Rollback;
+	uint64_t		m_Tick;
+	bool			m_RewindRequested;
+
+	// enemies in the group when it was last sorted, and the sort's keys
+	size_t					m_SortedEnemies;
+	std::vector<uint32_t>	m_SortKeys;
+
+	std::vector<Memory::StorageStats>	m_StorageStats;
+	bool								m_StorageReportRequested;
 
 	std::string		m_Title;
 	uint32_t		m_Width;
 	uint32_t		m_Height;
 
 	bool			m_Running;
+	bool			m_SoftwareRendering;
+	bool			m_IncrementalRedraw;
+	bool			m_Headless;
+
+	uint64_t		m_FrameIndex;
+	uint64_t		m_FrameLimit;
+	int				m_ExitCode;
+
+	RenderCommandBuffer	m_Commands;
+	SDLRenderBackend	m_Backend;
+	StaticLayer			m_StaticLayer;
+
+	JobSystem			m_Jobs;
+	SoftwareRasterizer	m_Rasterizer;
+	SDL_Texture*		m_FrameTexture;
+
+	DamageTracker		m_Damage;
+	SDL_Texture*		m_BackBuffer;
+
+	FrameCapture		m_Capture;
+	std::string			m_CaptureDirectory;
+	CaptureFormat		m_CaptureFormat;
+	std::string			m_GoldenPath;
+	bool				m_ScreenshotRequested;
+
+	FrameStats			m_Stats;
+	DebugOverlay		m_Overlay;
+	bool				m_ShowOverlay;
+
+	// overlay values are averaged over a few frames and only reformatted when they change
+	uint32_t			m_OverlayFrames;
+	double				m_OverlayFrameMs;
+	double				m_OverlayTickMs;
+	long long			m_OverlayShown[7];
 
 };
\ No newline at end of file
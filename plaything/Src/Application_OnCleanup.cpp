@@ -1,9 +1,49 @@
 #include "Application.hpp"
 
+#include "Serialization/SceneSnapshot.hpp"
+
+#include <iostream>
+
 void Application::OnCleanup()
 {
+	// flushes frames still being encoded
+	m_Capture.Stop();
+
+	if (m_BackBuffer)
+	{
+		m_Damage.Disconnect(m_Scene);
+		SDL_DestroyTexture(m_BackBuffer);
+	}
+
+	if (m_StaticLayer.Enabled())
+	{
+		m_StaticLayer.Disconnect(m_Scene);
+		m_StaticLayer.Shutdown();
+	}
+
+	m_Overlay.Shutdown();
+
+	// streamed chunks are written back and leave the scene, their health bars with them
+	if (m_World.Enabled())
+	{
+		m_World.Stop(m_Scene);
+		m_Hierarchy.Update(m_Scene);
+	}
+
+	// searches in flight point into the scene
+	m_Paths.Stop();
+
+	m_Hierarchy.Disconnect(m_Scene);
+	m_Navigation.Disconnect(m_Scene);
+
+	if (!m_SavePath.empty() && !Serialization::SaveScene(m_Scene, m_SavePath.c_str()))
+		std::cout << "failed to save scene to " << m_SavePath << std::endl;
+
 	m_Scene.clear();
 
+	if (m_FrameTexture)
+		SDL_DestroyTexture(m_FrameTexture);
+
 	SDL_DestroyRenderer(m_Renderer);
 	SDL_DestroyWindow(m_Window);
 }
\ No newline at end of file
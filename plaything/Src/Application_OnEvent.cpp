@@ -1,9 +1,8 @@
 #include "Application.hpp"
 
-#include "Components/QuadComponent.hpp"
-#include "Components/QuadColliderComponent.hpp"
 #include "Components/SpeedComponent.hpp"
 #include "Components/Tags.hpp"
+#include "Components/TransformComponent.hpp"
 
 #include "Vector2.hpp"
 
@@ -16,6 +15,39 @@ void Application::OnEvent(SDL_Event* Event)
 		case SDL_QUIT:
 		{
 			m_Running = false;
+			break;
+		}
+
+		case SDL_KEYDOWN:
+		{
+			if (Event->key.keysym.scancode == SDL_SCANCODE_F12)
+				m_ScreenshotRequested = true;
+
+			if (Event->key.keysym.scancode == SDL_SCANCODE_F3)
+				m_ShowOverlay = !m_ShowOverlay;
+
+			if (Event->key.keysym.scancode == SDL_SCANCODE_F5)
+				m_WaveRequested = true;
+
+			if (Event->key.keysym.scancode == SDL_SCANCODE_F6)
+				m_ScatterRequested = true;
+
+			if (Event->key.keysym.scancode == SDL_SCANCODE_F7)
+				m_RewindRequested = true;
+
+			if (Event->key.keysym.scancode == SDL_SCANCODE_F9)
+				m_StorageReportRequested = true;
+
+			break;
+		}
+
+		// render target contents are lost with the device
+		case SDL_RENDER_TARGETS_RESET:
+		case SDL_RENDER_DEVICE_RESET:
+		{
+			m_Damage.InvalidateAll();
+			m_StaticLayer.InvalidateAll();
+			break;
 		}
 	}
 
@@ -54,16 +86,12 @@ void Application::HandlePlayerInput(SDL_Event* Event)
 
 void Application::PlayerMovement(Vector2 Direction)
 {
-	auto Player	= m_Scene.view<QuadComponent, Tags::Player>().front();
-
-	auto& PlayerTransform	= m_Scene.get<QuadComponent>(Player);
-	auto& PlayerCollider	= m_Scene.get<QuadColliderComponent>(Player);
-	float PlayerSpeed		= m_Scene.get<SpeedComponent>(Player).Speed;
+	auto Player	= m_Scene.view<TransformComponent, Tags::Player>().front();
 
+	auto& PlayerTransform	= m_Scene.get<TransformComponent>(Player);
+	SimScalar PlayerSpeed	= m_Scene.get<SpeedComponent>(Player).Speed;
 
-	PlayerTransform.m_Quad.x += Direction.x * PlayerSpeed;
-	PlayerTransform.m_Quad.y += Direction.y * PlayerSpeed;
 
-	PlayerCollider.m_Quad.x  += Direction.x * PlayerSpeed;
-	PlayerCollider.m_Quad.y  += Direction.y * PlayerSpeed;
+	// collider bounds follow in the next bounds pass
+	PlayerTransform.Translate(SimVector2(Direction) * PlayerSpeed);
 }
\ No newline at end of file
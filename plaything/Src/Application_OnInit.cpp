@@ -1,11 +1,16 @@
 #include "Application.hpp"
 
+#include "LevelMetadata.hpp"
 #include "Logging.hpp"
+#include "Prefabs.hpp"
 
-#include "Components/QuadComponent.hpp"
-#include "Components/QuadColliderComponent.hpp"
-#include "Components/SpeedComponent.hpp"
-#include "Components/Tags.hpp"
+
+#include "Serialization/SceneSnapshot.hpp"
+
+#include "Systems/Groups.hpp"
+
+#include <algorithm>
+#include <iostream>
 
 bool Application::OnInit()
 {
@@ -14,7 +19,7 @@ bool Application::OnInit()
 								SDL_WINDOWPOS_CENTERED,
 								m_Width,
 								m_Height,
-								SDL_WINDOW_SHOWN);
+								m_Headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
 
 	if (!m_Window)
 	{
@@ -22,7 +27,8 @@ bool Application::OnInit()
 		return false;
 	}
 
-	m_Renderer = SDL_CreateRenderer(m_Window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+	// headless runs go as fast as they can
+	m_Renderer = SDL_CreateRenderer(m_Window, -1, m_Headless ? 0 : SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
 
 	if (!m_Renderer)
 	{
@@ -30,22 +36,145 @@ bool Application::OnInit()
 		return false;
 	}
 
+	m_Backend.SetRenderer(m_Renderer);
+
+	if (m_SoftwareRendering)
+	{
+		m_FrameTexture = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, m_Width, m_Height);
+
+		if (!m_FrameTexture)
+		{
+			DebugLog();
+			return false;
+		}
+
+		m_Rasterizer.Resize(m_Width, m_Height);
+	}
+	else if (m_IncrementalRedraw)
+	{
+		m_BackBuffer = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, m_Width, m_Height);
+
+		if (!m_BackBuffer)
+		{
+			DebugLog();
+			return false;
+		}
+
+		m_Damage.Resize(m_Width, m_Height);
+		m_Damage.Connect(m_Scene);
+	}
+
+	// cached static geometry lives in render targets, the software path draws it directly
+	if (!m_SoftwareRendering)
+	{
+		m_StaticLayer.Init(m_Renderer, m_Width, m_Height);
+		m_StaticLayer.Connect(m_Scene);
+	}
+
+
+	m_Capture.Start();
+
+	if (!m_Overlay.Init(m_Renderer))
+		return false;
+
+
+	// groups are set up before anything is spawned so they never have to sort existing storages
+	Groups::Enemies(m_Scene);
+	Groups::Movers(m_Scene);
+	m_Hierarchy.Connect(m_Scene);
+
+	// walls spawned from here on mark the grid for a rebuild
+	m_Navigation.Resize(Vector2(0, 0), int32_t((m_Width + WallTile - 1) / WallTile), int32_t((m_Height + WallTile - 1) / WallTile), NavigationCell);
+	m_Navigation.Connect(m_Scene);
+	m_Paths.Start(PathWorkers);
 
 	InitResource();
 
+	if (!m_WorldDirectory.empty() && !m_World.Start(m_WorldDirectory))
+		std::cout << "failed to open world directory " << m_WorldDirectory << std::endl;
+
 	return true;
 }
 
 void Application::InitResource()
 {
-	entt::entity Player = m_Scene.create();
-	m_Scene.emplace<Tags::Player>(Player);
-	m_Scene.emplace<QuadComponent>(Player, 10, 10, TileW, TileH);
-	m_Scene.emplace<QuadColliderComponent>(Player, 10, 10, TileW, TileH);
-	m_Scene.emplace<SpeedComponent>(Player, 10.0f);
-
-	entt::entity Mob = m_Scene.create();
-	m_Scene.emplace<Tags::Enemy>(Mob);
-	m_Scene.emplace<QuadComponent>(Mob, 900, 500, TileW, TileH);
-	m_Scene.emplace<QuadColliderComponent>(Mob, 900, 500, TileW, TileH);
-}
\ No newline at end of file
+	m_Level.FloorTiles	= ((m_Width + FloorTile - 1) / FloorTile) * ((m_Height + FloorTile - 1) / FloorTile);
+	m_Level.WallTiles	= ((m_Width + WallTile - 1) / WallTile) * 2 + ((m_Height - WallTile - 1) / WallTile) * 2;
+	m_Level.Players		= 1;
+	m_Level.MaxEnemies	= MaxEnemies;
+	m_Level.Attachments	= MaxEnemies + 1;	// a health bar per enemy, the player's weapon
+
+	m_Level.Reserve(m_Scene);
+	m_Rollback.Init(RollbackTicks, m_Level);
+
+	m_Spawned.reserve(std::max(m_Level.FloorTiles, WaveSize));
+	m_SpawnTransforms.reserve(std::max(m_Level.FloorTiles, WaveSize));
+	m_SpawnVelocities.reserve(WaveSize);
+	m_SpawnAttachments.reserve(WaveSize);
+	m_SortKeys.reserve(m_Level.Entities());
+
+	if (!m_LoadPath.empty())
+	{
+		if (Serialization::LoadScene(m_Scene, m_LoadPath.c_str()))
+		{
+			std::cout << "scene loaded from " << m_LoadPath << ", " << m_Scene.storage<entt::entity>().in_use() << " entities" << std::endl;
+			return;
+		}
+
+		// partially loaded at worst, start over from code
+		std::cout << "scene " << m_LoadPath << " missing or invalid, building the level" << std::endl;
+		m_Scene.clear();
+	}
+
+	// floor, checkered so the static layer has something to cache.
+	// one bulk spawn per shade
+	for (uint8_t Shade : { uint8_t(24), uint8_t(32) })
+	{
+		m_SpawnTransforms.clear();
+
+		for (uint32_t y = 0; y < m_Height; y += FloorTile)
+		{
+			for (uint32_t x = 0; x < m_Width; x += FloorTile)
+			{
+				if ((((x / FloorTile + y / FloorTile) % 2) ? 24 : 32) == Shade)
+					m_SpawnTransforms.emplace_back(float(x), float(y));
+			}
+		}
+
+		m_Spawned.resize(m_SpawnTransforms.size());
+		Prefabs::Floor(float(FloorTile), Shade).Spawn(m_Scene, m_Spawned.begin(), m_Spawned.end(), m_SpawnTransforms.begin());
+	}
+
+	// walls along the window edges
+	m_SpawnTransforms.clear();
+
+	for (uint32_t x = 0; x < m_Width; x += WallTile)
+	{
+		for (uint32_t y : { 0u, m_Height - WallTile })
+			m_SpawnTransforms.emplace_back(float(x), float(y));
+	}
+
+	for (uint32_t y = WallTile; y < m_Height - WallTile; y += WallTile)
+	{
+		for (uint32_t x : { 0u, m_Width - WallTile })
+			m_SpawnTransforms.emplace_back(float(x), float(y));
+	}
+
+	m_Spawned.resize(m_SpawnTransforms.size());
+	Prefabs::Wall(float(WallTile)).Spawn(m_Scene, m_Spawned.begin(), m_Spawned.end(), m_SpawnTransforms.begin());
+
+	TransformComponent PlayerTransform(10, 10);
+	entt::entity Player;
+	Prefabs::Player(TileW, TileH, 10.0f).Spawn(m_Scene, &Player, &Player + 1, &PlayerTransform);
+
+	// weapon sticking out of the player's right side
+	HierarchyComponent WeaponAttachment(Player, Vector2(float(TileW), float(TileH) / 2 - 5));
+	entt::entity Weapon;
+	Prefabs::Attachment(30, 10, 255, 220, 0).Spawn(m_Scene, &Weapon, &Weapon + 1, &WeaponAttachment);
+
+	TransformComponent MobTransform(900, 500);
+	m_Spawned.resize(1);
+	Prefabs::Enemy(TileW, TileH).Spawn(m_Scene, m_Spawned.begin(), m_Spawned.end(), &MobTransform);
+
+	AttachHealthBars();
+}
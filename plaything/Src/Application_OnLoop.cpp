@@ -3,20 +3,218 @@
 #include "Components/QuadColliderComponent.hpp"
 #include "Components/Tags.hpp"
 
+#include "Prefabs.hpp"
+
+#include "Memory/PageArena.hpp"
+
+#include "Systems/ColliderBoundsSystem.hpp"
+#include "Systems/CollisionSystem.hpp"
+#include "Systems/Groups.hpp"
+#include "Systems/MovementSystem.hpp"
+#include "Systems/SpatialSortSystem.hpp"
+
+#include <algorithm>
+#include <iostream>
+
 void Application::OnLoop()
 {
+	// chunks enter and leave the scene at the frame boundary, before anything iterates it
+	if (m_World.Enabled())
+		StreamWorld();
+
+	if (m_RewindRequested)
+	{
+		Rewind();
+		m_RewindRequested = false;
+	}
+
+	if (m_WaveRequested)
+	{
+		SpawnWave();
+		m_WaveRequested = false;
+	}
+
+	if (m_ScatterRequested)
+	{
+		Scatter();
+		m_ScatterRequested = false;
+	}
+
+	// enemies steer along the field towards the player, or along a path of
+	// their own while they have one, then everything moves. The field only
+	// rebuilds when the player changes cell or a wall changed, enemies far
+	// from the player or off screen steer less often
+	auto PlayerTransforms = m_Scene.view<TransformComponent, Tags::Player>();
+
+	m_Navigation.Update(m_Scene, m_Jobs);
+	m_Paths.Update(m_Scene, m_Navigation);
+
+	if (PlayerTransforms.begin() != PlayerTransforms.end())
+	{
+		const SimVector2 Player = PlayerTransforms.get<TransformComponent>(PlayerTransforms.front()).m_Position;
+
+		m_Lod.Begin(m_Tick, Player, Vector2(0, 0), Vector2(float(m_Width), float(m_Height)), {});
+		m_FlowField.Update(m_Navigation, m_Jobs, Player);
+		m_Flocking.Update(m_Scene, m_Jobs, m_FlowField, m_Lod, {});
+	}
+
+	Systems::IntegrateMovement(m_Scene, TickSeconds, { EnemyDamping, EnemyMaxSpeed });
+
+	// attachments follow whatever moved, before anything derives data from transforms
+	m_Hierarchy.Update(m_Scene);
+	Systems::UpdateColliderBounds(m_Scene);
+
 	auto PlayerView	= m_Scene.view<QuadColliderComponent, Tags::Player>();
-	auto EnemyView	= m_Scene.view<QuadColliderComponent, Tags::Enemy>();
+	auto Enemies	= Groups::Enemies(m_Scene);
 
-	auto& PlayerCollider = m_Scene.get<QuadColliderComponent>(PlayerView.front());
-	
-	for (auto Entity : EnemyView)
+	// keep the enemy storages in Z-order. Insertion sorts while the group
+	// only drifted, a full sort once a wave or enough deaths reshuffled it
+	if (m_Tick % SpatialSortInterval == 0)
 	{
-		auto& EnemyCollider = m_Scene.get<QuadColliderComponent>(Entity);
+		const size_t Churn = Enemies.size() > m_SortedEnemies ? Enemies.size() - m_SortedEnemies : m_SortedEnemies - Enemies.size();
+
+		Systems::SortEnemiesSpatially(m_Scene, Churn <= Enemies.size() / 16, m_SortKeys);
+		m_SortedEnemies = Enemies.size();
+	}
+
+	auto& PlayerCollider = PlayerView.get<QuadColliderComponent>(PlayerView.front());
+
+	m_Stats.CollisionPairs = static_cast<uint32_t>(Enemies.size());
+
+	Systems::CollectEnemyHits(m_Scene, PlayerCollider.m_Bounds, m_Hits);
+
+	// destroying reorders the owned storages, don't do it mid iteration
+	m_Scene.destroy(m_Hits.begin(), m_Hits.end());
+	m_Hits.clear();
+
+	if (m_StorageReportRequested || m_Tick % StorageStatsInterval == 0)
+		UpdateStorageStats();
+
+	m_Rollback.Save(m_Scene, m_Tick++);
+}
+void Application::SpawnWave()
+{
+	// never past what the storages were reserved for
+	uint32_t Alive = static_cast<uint32_t>(m_Scene.storage<Tags::Enemy>().size());
+	uint32_t Count = std::min(WaveSize, m_Level.MaxEnemies - std::min(Alive, m_Level.MaxEnemies));
+
+	if (Count == 0)
+		return;
+
+	std::uniform_real_distribution<float> SpawnX(float(WallTile), float(m_Width - WallTile - TileW));
+	std::uniform_real_distribution<float> SpawnY(float(WallTile), float(m_Height - WallTile - TileH));
+	std::uniform_real_distribution<float> Drift(-WaveSpeed, WaveSpeed);
+
+	m_SpawnTransforms.clear();
+	m_SpawnVelocities.clear();
+
+	for (uint32_t i = 0; i < Count; i++)
+	{
+		m_SpawnTransforms.emplace_back(SpawnX(m_Random), SpawnY(m_Random));
+		m_SpawnVelocities.emplace_back(Drift(m_Random), Drift(m_Random));
+	}
+
+	SpawnEnemies(m_SpawnTransforms, m_SpawnVelocities);
+}
 
-		if (SDL_HasIntersectionF(PlayerCollider, EnemyCollider) == SDL_TRUE)
-		{
-			m_Scene.destroy(Entity);
-		}
+void Application::Scatter()
+{
+	// every enemy heads for a spot of its own inside the walls, then back to the player once there
+	std::uniform_real_distribution<float> GoalX(float(WallTile), float(m_Width - WallTile));
+	std::uniform_real_distribution<float> GoalY(float(WallTile), float(m_Height - WallTile));
+
+	for (auto Entity : m_Scene.view<Tags::Enemy>())
+	{
+		const float x = GoalX(m_Random);
+		const float y = GoalY(m_Random);
+
+		m_Paths.Request(m_Scene, Entity, SimVector2(Vector2(x, y)));
+	}
+}
+
+void Application::SpawnEnemies(const std::vector<TransformComponent>& Transforms, const std::vector<VelocityComponent>& Velocities)
+{
+	if (Transforms.empty())
+		return;
+
+	m_Spawned.resize(Transforms.size());
+	Prefabs::Enemy(TileW, TileH).Spawn(m_Scene, m_Spawned.begin(), m_Spawned.end(), Transforms.begin(), Velocities.begin());
+
+	AttachHealthBars();
+}
+
+void Application::StreamWorld()
+{
+	auto PlayerView = m_Scene.view<TransformComponent, Tags::Player>();
+
+	if (PlayerView.begin() == PlayerView.end())
+		return;
+
+	const Vector2 Focus(PlayerView.get<TransformComponent>(PlayerView.front()).m_Position);
+
+	// chunks wait in the streamer until they fit in what the storages were reserved for
+	const bool Streamed = m_World.Update(m_Scene, Focus, [this](const WorldStreamer::Chunk& Loaded)
+	{
+		const size_t Alive = m_Scene.storage<Tags::Enemy>().size();
+
+		if (Alive + Loaded.Enemies.size() > m_Level.MaxEnemies)
+			return false;
+
+		SpawnEnemies(Loaded.Enemies, Loaded.Velocities);
+
+		return true;
+	});
+
+	// rewinding past it would bring back enemies that are on disk now, or
+	// lose ones whose chunk counts as loaded
+	if (Streamed)
+		m_Rollback.Clear();
+}
+
+void Application::AttachHealthBars()
+{
+	// one bar above every enemy in m_Spawned, all in one bulk spawn
+	m_SpawnAttachments.clear();
+
+	for (entt::entity Enemy : m_Spawned)
+		m_SpawnAttachments.emplace_back(Enemy, Vector2(0, -10));
+
+	m_Spawned.resize(m_SpawnAttachments.size());
+	Prefabs::Attachment(TileW, 6, 0, 200, 0).Spawn(m_Scene, m_Spawned.begin(), m_Spawned.end(), m_SpawnAttachments.begin());
+}
+
+void Application::Rewind()
+{
+	if (m_Rollback.Empty())
+		return;
+
+	const uint64_t Target = std::max(m_Rollback.Oldest(), m_Rollback.Newest() - std::min(RewindTicks, m_Rollback.Newest()));
+
+	const uint64_t Start = SDL_GetPerformanceCounter();
+
+	if (!m_Rollback.Restore(m_Scene, Target))
+		return;
+
+	m_Hierarchy.Invalidate();
+
+	const double Micros = double(SDL_GetPerformanceCounter() - Start) * 1000000.0 / double(SDL_GetPerformanceFrequency());
+
+	std::cout << "rewound to tick " << Target << " in " << Micros << " us" << std::endl;
+
+	// simulation carries on from the restored tick
+	m_Tick = Target + 1;
+}
+
+void Application::UpdateStorageStats()
+{
+	Memory::CollectStorageStats(m_Scene, m_StorageStats);
+
+	m_Stats.StorageBytes	= Memory::TotalBytes(m_StorageStats);
+	m_Stats.PoolBytes		= Memory::PageArena::Get().ReservedBytes();
+
+	if (m_StorageReportRequested)
+	{
+		Memory::PrintStorageStats(m_StorageStats);
+		m_StorageReportRequested = false;
 	}
-}
\ No newline at end of file
+}
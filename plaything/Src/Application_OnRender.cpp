@@ -1,39 +1,242 @@
 #include "Application.hpp"
 
-#include "Components/QuadComponent.hpp"
-#include "Components/Tags.hpp"
+#include "Systems/RenderPrepSystem.hpp"
+
+#include <cstdio>
+#include <iostream>
 
 void Application::OnRender()
 {
+	m_Backend.ResetStats();
+
+	auto& Recording = m_Commands.Record();
+
+	if (m_StaticLayer.Enabled())
+	{
+		for (const auto& Rect : m_StaticLayer.Update(m_Scene, m_Backend))
+			m_Damage.Invalidate(SDL_FRect{ float(Rect.x), float(Rect.y), float(Rect.w), float(Rect.h) });
+
+		m_StaticLayer.Composite(Recording);
+	}
+
+	Systems::RenderPrep(m_Scene, Recording, !m_StaticLayer.Enabled());
+	m_Commands.Swap();
+
+	const auto& Commands = m_Commands.Commands();
+
+	if (m_SoftwareRendering)
+	{
+		RenderSoftware(Commands);
+		return;
+	}
+
+	if (m_IncrementalRedraw)
+	{
+		RenderIncremental(Commands);
+		return;
+	}
+
 	SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 255);
 	SDL_RenderClear(m_Renderer);
 
+	m_Backend.Execute(Commands);
 
-	// draw enemy
-	auto EnemyView = m_Scene.view<QuadComponent, Tags::Enemy>();
-	for (auto Entity : EnemyView)
-	{
-		auto& Quad = m_Scene.get<QuadComponent>(Entity);
+	PresentFrame();
+}
+
+
+void Application::RenderSoftware(const RenderCommandList& Commands)
+{
+	m_Rasterizer.Clear(0, 0, 0, 255);
+	m_Rasterizer.Execute(Commands);
+	m_Rasterizer.Flush(m_Jobs);
 
-		SDL_SetRenderDrawColor(m_Renderer, 255, 0, 0, 255);
-		SDL_RenderFillRectF(m_Renderer, Quad);
-		SDL_RenderDrawRectF(m_Renderer, Quad);
+	SDL_UpdateTexture(m_FrameTexture, nullptr, m_Rasterizer.Pixels(), m_Rasterizer.Pitch());
+	SDL_RenderCopy(m_Renderer, m_FrameTexture, nullptr, nullptr);
+	PresentFrame();
+}
 
+
+void Application::RenderIncremental(const RenderCommandList& Commands)
+{
+	for (const auto& Command : Commands)
+	{
+		if (Command.Type == RenderCommandType::Quad)
+			m_Damage.Track(entt::entity{ Command.Quad.Id }, Command.Quad.Rect);
 	}
 
 
-	// draw player
-	auto PlayerView = m_Scene.view<QuadComponent, Tags::Player>();
-	for (auto Entity : PlayerView)
+	const auto& DirtyRects = m_Damage.Resolve();
+
+	if (!DirtyRects.empty())
 	{
-		auto& Quad = m_Scene.get<QuadComponent>(Entity);
+		SDL_SetRenderTarget(m_Renderer, m_BackBuffer);
+
+		for (const auto& Dirty : DirtyRects)
+		{
+			// SDL_RenderClear ignores the clip rect, so clear with a fill
+			SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 255);
+			SDL_RenderFillRect(m_Renderer, &Dirty);
 
-		SDL_SetRenderDrawColor(m_Renderer, 0, 255, 255, 255);
-		SDL_RenderFillRectF(m_Renderer, Quad);
-		SDL_RenderDrawRectF(m_Renderer, Quad);
+			m_Backend.Execute(Commands, &Dirty);
+		}
 
+		SDL_SetRenderTarget(m_Renderer, nullptr);
 	}
 
 
+	SDL_RenderCopy(m_Renderer, m_BackBuffer, nullptr, nullptr);
+	PresentFrame();
+}
+
+
+
+void Application::PresentFrame()
+{
+	// the back buffer is undefined after presenting, read it back before
+	const bool Dump		= !m_CaptureDirectory.empty();
+	const bool Golden	= !m_GoldenPath.empty() && m_FrameIndex + 1 == m_FrameLimit;
+
+	if (Dump || Golden || m_ScreenshotRequested)
+		CaptureFrame(Dump, Golden);
+
+	// drawn after the capture so golden images don't depend on timings
+	if (m_ShowOverlay)
+	{
+		UpdateOverlay();
+		m_Overlay.Render(m_Renderer);
+	}
+
 	SDL_RenderPresent(m_Renderer);
+}
+
+
+void Application::CaptureFrame(bool Dump, bool Golden)
+{
+	CaptureImage* Image = m_Capture.Acquire(m_Width, m_Height);
+
+	if (m_SoftwareRendering)
+	{
+		FrameCapture::ReadPixels(m_Rasterizer.Pixels(), m_Rasterizer.Pitch(), *Image);
+	}
+	else if (!FrameCapture::ReadRenderer(m_Renderer, *Image))
+	{
+		m_Capture.Release(Image);
+		return;
+	}
+
+
+	if (Golden)
+	{
+		const int64_t Mismatched = FrameCapture::CompareGolden(*Image, m_GoldenPath);
+
+		if (Mismatched == FrameCapture::GoldenMissing)
+		{
+			std::cout << "golden image " << m_GoldenPath << " missing, writing it" << std::endl;
+			FrameCapture::Encode(*Image, m_GoldenPath, CaptureFormat::PNG);
+		}
+		else if (Mismatched == FrameCapture::GoldenUnreadable)
+		{
+			// never overwritten, a golden of another resolution or a corrupt one fails the run
+			std::cout << "golden image " << m_GoldenPath << " can't be read or isn't " << m_Width << "x" << m_Height << std::endl;
+			m_ExitCode = 1;
+		}
+		else if (Mismatched > 0)
+		{
+			std::cout << "golden image " << m_GoldenPath << " mismatch, " << Mismatched << " pixels differ" << std::endl;
+			m_ExitCode = 1;
+		}
+		else
+		{
+			std::cout << "golden image " << m_GoldenPath << " matches" << std::endl;
+		}
+	}
+
+
+	const char* Extension = m_CaptureFormat == CaptureFormat::PNG ? "png" : "raw";
+	char Path[512]{};
+
+	if (m_ScreenshotRequested)
+	{
+		m_ScreenshotRequested = false;
+
+		snprintf(Path, sizeof(Path), "screenshot_%llu.png", static_cast<unsigned long long>(m_FrameIndex));
+
+		// a dump of the same frame needs its own copy
+		if (Dump)
+		{
+			CaptureImage* Copy = m_Capture.Acquire(Image->Width, Image->Height);
+			Copy->Pixels = Image->Pixels;
+
+			m_Capture.Submit(Copy, Path, CaptureFormat::PNG);
+		}
+		else
+		{
+			m_Capture.Submit(Image, Path, CaptureFormat::PNG);
+			return;
+		}
+	}
+
+	if (Dump)
+	{
+		snprintf(Path, sizeof(Path), "%s/frame_%06llu.%s", m_CaptureDirectory.c_str(), static_cast<unsigned long long>(m_FrameIndex), Extension);
+		m_Capture.Submit(Image, Path, m_CaptureFormat);
+		return;
+	}
+
+	m_Capture.Release(Image);
+}
+
+
+void Application::UpdateOverlay()
+{
+	m_Stats.Entities	= static_cast<uint32_t>(m_Scene.storage<entt::entity>().in_use());
+	m_Stats.DrawCalls	= m_SoftwareRendering ? m_Rasterizer.Primitives() : m_Backend.DrawCalls();
+
+	m_OverlayFrameMs	+= m_Stats.FrameMs;
+	m_OverlayTickMs		+= m_Stats.TickMs;
+
+	const bool Publish = ++m_OverlayFrames >= OverlayInterval;
+
+	// timings in hundredths of a millisecond
+	const long long Values[] =
+	{
+		Publish ? (long long)(m_OverlayFrameMs * 100.0 / m_OverlayFrames)	: m_OverlayShown[0],
+		Publish ? (long long)(m_OverlayTickMs * 100.0 / m_OverlayFrames)	: m_OverlayShown[1],
+		m_Stats.Entities,
+		m_Stats.DrawCalls,
+		m_Stats.CollisionPairs,
+		(long long)(m_Stats.StorageBytes / 1024),
+		(long long)(m_Stats.PoolBytes / 1024),
+	};
+
+	if (Publish)
+	{
+		m_OverlayFrames		= 0;
+		m_OverlayFrameMs	= 0.0;
+		m_OverlayTickMs		= 0.0;
+	}
+
+	char Line[64]{};
+
+	for (size_t i = 0; i < std::size(Values); ++i)
+	{
+		if (Values[i] == m_OverlayShown[i])
+			continue;
+
+		m_OverlayShown[i] = Values[i];
+
+		switch (i)
+		{
+			case 0: snprintf(Line, sizeof(Line), "frame    %4lld.%02lld ms", Values[i] / 100, Values[i] % 100); break;
+			case 1: snprintf(Line, sizeof(Line), "tick     %4lld.%02lld ms", Values[i] / 100, Values[i] % 100); break;
+			case 2: snprintf(Line, sizeof(Line), "entities %7lld", Values[i]); break;
+			case 3: snprintf(Line, sizeof(Line), "draws    %7lld", Values[i]); break;
+			case 4: snprintf(Line, sizeof(Line), "pairs    %7lld", Values[i]); break;
+			case 5: snprintf(Line, sizeof(Line), "storage  %7lld KB", Values[i]); break;
+			case 6: snprintf(Line, sizeof(Line), "pool     %7lld KB", Values[i]); break;
+		}
+
+		m_Overlay.SetLine(i, Line);
+	}
 }
\ No newline at end of file
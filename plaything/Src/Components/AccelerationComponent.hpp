@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../Simulation.hpp"
+
+// units per second squared, integrated into the velocity every tick. Kept
+// until something changes it, behaviours overwrite it with their steering
+
+struct AccelerationComponent
+{
+public:
+
+	SimVector2	m_Acceleration;
+
+
+public:
+
+	AccelerationComponent(float x = 0, float y = 0)
+		: m_Acceleration(SimScalar(x), SimScalar(y)) { }
+
+	~AccelerationComponent() = default;
+};
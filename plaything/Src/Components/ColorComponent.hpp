@@ -0,0 +1,18 @@
+#pragma once
+
+#include <SDL2/SDL_pixels.h>
+
+struct ColorComponent
+{
+public:
+
+	SDL_Color	m_Color;
+
+
+public:
+
+	ColorComponent(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255)
+		: m_Color(SDL_Color(r, g, b, a)) { }
+
+	~ColorComponent() = default;
+};
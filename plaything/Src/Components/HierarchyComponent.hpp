@@ -0,0 +1,39 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../Simulation.hpp"
+
+#include <cstdint>
+
+// attaches an entity to a parent, its transform follows the parent's at a
+// fixed offset. Only children carry this, roots are plain transforms.
+// Everything below m_Local is owned by TransformHierarchy, and so are
+// changes to m_Local once attached (TransformHierarchy::SetLocal).
+
+struct HierarchyComponent
+{
+public:
+
+	static constexpr uint32_t Root = ~0u;
+
+	entt::entity	m_Parent;
+	SimVector2		m_Local;
+
+	uint32_t		m_ParentIndex;	// parent's slot in the hierarchy storage, Root if the parent is a root
+	uint32_t		m_Subtree;		// nodes in its subtree, itself included
+	SimVector2		m_World;
+
+	bool			m_Dirty;		// local offset changed
+	bool			m_DirtyBelow;	// a node in its subtree has a changed offset
+	bool			m_Moved;		// world position changed in the last pass
+	bool			m_Packed;		// its subtree fills the m_Subtree slots starting at its own
+
+
+public:
+
+	HierarchyComponent(entt::entity Parent, Vector2 Local)
+		: m_Parent(Parent), m_Local(Local), m_ParentIndex(Root), m_Subtree(1), m_World(), m_Dirty(true), m_DirtyBelow(false), m_Moved(false), m_Packed(false) { }
+
+	~HierarchyComponent() = default;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../Simulation.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// an enemy that walks somewhere other than the flow field's goal. It holds
+// a goal of its own and the waypoints there, requested through the path
+// planner and filled in once a worker found them. Not part of snapshots or
+// rollback, a path is asked for again rather than restored.
+
+struct PathComponent
+{
+public:
+
+	enum class State : uint8_t
+	{
+		Pending,
+		Ready,
+		Failed,
+	};
+
+	SimVector2				m_Goal;
+	std::vector<SimVector2>	m_Waypoints;
+	uint32_t				m_Next;
+
+	State					m_State;
+	uint32_t				m_Ticket;	// which request the waypoints answer
+
+
+public:
+
+	PathComponent(SimVector2 Goal = SimVector2(), uint32_t Ticket = 0)
+		: m_Goal(Goal), m_Next(0), m_State(State::Pending), m_Ticket(Ticket) { }
+
+	~PathComponent() = default;
+
+
+public:
+
+	// past the waypoints within Reach, or already behind on the way to the
+	// one after (a crowd can't all squeeze into Reach of the same corner),
+	// then the way to the next one. False while pending, after failing and
+	// once the last one is reached
+	bool Follow(SimVector2 Position, SimScalar Reach, SimVector2& Direction)
+	{
+		if (m_State != State::Ready)
+			return false;
+
+		while (m_Next < m_Waypoints.size())
+		{
+			const bool Reached	= !((m_Waypoints[m_Next] - Position).MagnitudeSquared() > Reach * Reach);
+			const bool Passed	= m_Next + 1 < m_Waypoints.size() && (Position - m_Waypoints[m_Next]).Dot(m_Waypoints[m_Next + 1] - m_Waypoints[m_Next]) > SimScalar();
+
+			if (!Reached && !Passed)
+				break;
+
+			m_Next++;
+		}
+
+		if (m_Next == m_Waypoints.size())
+			return false;
+
+		Direction = (m_Waypoints[m_Next] - Position).NormalizeSafe();
+
+		return true;
+	}
+
+	bool Finished() const { return m_State == State::Failed || (m_State == State::Ready && m_Next == m_Waypoints.size()); }
+};
@@ -1,23 +1,48 @@
 #pragma once
 
-#include <SDL2/SDL_rect.h>
+#include "TransformComponent.hpp"
+
+// axis aligned box by its corners, in simulation units. Overlap is strict,
+// boxes that only touch don't collide (same as SDL_HasIntersectionF)
+
+struct ColliderBox
+{
+	SimVector2	m_Min;
+	SimVector2	m_Max;
+
+	bool Overlaps(const ColliderBox& Other) const
+	{
+		// & rather than &&, four compares beat a branch per compare
+		return (m_Min.x < Other.m_Max.x) & (Other.m_Min.x < m_Max.x) & (m_Min.y < Other.m_Max.y) & (Other.m_Min.y < m_Max.y);
+	}
+};
+
+// collision rectangle local to the transform. World bounds are derived
+// in one pass before collision, only for transforms that moved.
 
 struct QuadColliderComponent
 {
 public:
 
-	SDL_FRect	m_Quad;
+	SimVector2	m_Offset;
+	SimVector2	m_Size;
+
+	ColliderBox	m_Bounds;
 
 
 public:
 
-	QuadColliderComponent(float x, float y, float w, float h)
-		: m_Quad(SDL_FRect(x, y, w, h)) { }
+	QuadColliderComponent(float w, float h, float OffsetX = 0, float OffsetY = 0)
+		: m_Offset(SimScalar(OffsetX), SimScalar(OffsetY)), m_Size(SimScalar(w), SimScalar(h)), m_Bounds() { }
 
 	~QuadColliderComponent() = default;
 
 
 public:
 
-	operator const SDL_FRect* () { return &m_Quad; }
+	void UpdateBounds(const TransformComponent& Transform)
+	{
+		m_Bounds.m_Min = Transform.m_Position + m_Offset;
+		m_Bounds.m_Max = m_Bounds.m_Min + m_Size;
+	}
 };
@@ -2,26 +2,34 @@
 
 #include <SDL2/SDL_rect.h>
 
-// component wrapper of SDL_FRect
+#include "TransformComponent.hpp"
+
+// rectangle drawn for an entity, local to its transform
 
 struct QuadComponent
 {
 
 public:
 
-	SDL_FRect	m_Quad;
+	Vector2	m_Offset;
+	Vector2	m_Size;
 
 
 public:
 	
-	QuadComponent(float x, float y, float w, float h)
-		: m_Quad(SDL_FRect(x, y, w, h)) { }
+	QuadComponent(float w, float h, float OffsetX = 0, float OffsetY = 0)
+		: m_Offset(OffsetX, OffsetY), m_Size(w, h) { }
 	
 	~QuadComponent() = default;
 
 
 public:
 
-	operator const SDL_FRect* () { return &m_Quad; }
+	SDL_FRect World(const TransformComponent& Transform) const
+	{
+		const Vector2 Position(Transform.m_Position);
+
+		return SDL_FRect(Position.x + m_Offset.x, Position.y + m_Offset.y, m_Size.x, m_Size.y);
+	}
 
-};
\ No newline at end of file
+};
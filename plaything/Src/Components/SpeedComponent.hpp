@@ -1,11 +1,13 @@
 #pragma once
 
+#include "../Simulation.hpp"
+
 struct SpeedComponent
 {
-	float Speed;
+	SimScalar Speed;
 
 	SpeedComponent(float speed)
-		:Speed(speed) { }
+		:Speed(SimScalar(speed)) { }
 
 	~SpeedComponent() = default;
 };
\ No newline at end of file
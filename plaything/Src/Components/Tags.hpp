@@ -4,4 +4,7 @@ namespace Tags
 {
 	struct Player {};
 	struct Enemy  {};
+
+	// geometry that never moves, drawn through the cached static layer
+	struct Static {};
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../Simulation.hpp"
+
+// world position of an entity, everything else is stored relative to it
+
+struct TransformComponent
+{
+public:
+
+	SimVector2	m_Position;
+
+	// set whenever the position changes, cleared once derived
+	// data (collider bounds) has caught up
+	bool		m_Dirty;
+
+
+public:
+
+	TransformComponent(float x, float y)
+		: m_Position(SimScalar(x), SimScalar(y)), m_Dirty(true) { }
+
+	~TransformComponent() = default;
+
+
+public:
+
+	void Translate(SimVector2 Delta)
+	{
+		m_Position	= m_Position + Delta;
+		m_Dirty		= true;
+	}
+};
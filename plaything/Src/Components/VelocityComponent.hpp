@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../Simulation.hpp"
+
+// units per second, integrated into the transform every tick
+
+struct VelocityComponent
+{
+public:
+
+	SimVector2	m_Velocity;
+
+
+public:
+
+	VelocityComponent(float x = 0, float y = 0)
+		: m_Velocity(SimScalar(x), SimScalar(y)) { }
+
+	~VelocityComponent() = default;
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+
+// Q16.16 fixed point, 16 integer and 16 fraction bits in an int32. Every
+// operation is integer math, so results are bit identical whatever the
+// compiler, flags or cpu, unlike float where contraction, x87 and fast math
+// all round differently. Arithmetic saturates instead of wrapping, a
+// position pushed past the range sticks at the edge.
+
+struct Fixed
+{
+
+public:
+
+	static constexpr int		FractionBits	= 16;
+	static constexpr int32_t	One				= 1 << FractionBits;
+
+	int32_t Raw;
+
+	constexpr Fixed()
+		: Raw(0)
+	{
+
+	}
+
+	constexpr explicit Fixed(int Value)
+		: Raw(Saturate(int64_t(Value) * One))
+	{
+
+	}
+
+	// rounds to nearest, only conversions are float here
+	constexpr explicit Fixed(float Value)
+		: Raw(0)
+	{
+		const double Scaled = double(Value) * One;
+
+		if (Scaled >= double(std::numeric_limits<int32_t>::max()))
+			Raw = std::numeric_limits<int32_t>::max();
+		else if (Scaled <= double(std::numeric_limits<int32_t>::min()))
+			Raw = std::numeric_limits<int32_t>::min();
+		else
+			Raw = int32_t(Scaled < 0.0 ? Scaled - 0.5 : Scaled + 0.5);
+	}
+
+	static constexpr Fixed FromRaw(int32_t Value)
+	{
+		Fixed Result;
+		Result.Raw = Value;
+
+		return Result;
+	}
+
+	constexpr explicit operator float() const { return float(Raw) / float(One); }
+
+
+public:
+
+	static constexpr int32_t Saturate(int64_t Value)
+	{
+		if (Value > std::numeric_limits<int32_t>::max())
+			return std::numeric_limits<int32_t>::max();
+
+		if (Value < std::numeric_limits<int32_t>::min())
+			return std::numeric_limits<int32_t>::min();
+
+		return int32_t(Value);
+	}
+
+
+public:
+
+	constexpr Fixed operator + (Fixed rhs) const { return FromRaw(Saturate(int64_t(Raw) + rhs.Raw)); }
+	constexpr Fixed operator - (Fixed rhs) const { return FromRaw(Saturate(int64_t(Raw) - rhs.Raw)); }
+	constexpr Fixed operator - ()			const { return FromRaw(Saturate(-int64_t(Raw))); }
+
+	// the product is rounded down, an arithmetic shift in C++20
+	constexpr Fixed operator * (Fixed rhs) const { return FromRaw(Saturate((int64_t(Raw) * rhs.Raw) >> FractionBits)); }
+
+	// dividing by zero saturates towards the sign of the dividend
+	constexpr Fixed operator / (Fixed rhs) const
+	{
+		if (rhs.Raw == 0)
+			return FromRaw(Raw == 0 ? 0 : Raw > 0 ? std::numeric_limits<int32_t>::max() : std::numeric_limits<int32_t>::min());
+
+		return FromRaw(Saturate((int64_t(Raw) * One) / rhs.Raw));
+	}
+
+	constexpr Fixed& operator += (Fixed rhs) { return *this = *this + rhs; }
+	constexpr Fixed& operator -= (Fixed rhs) { return *this = *this - rhs; }
+	constexpr Fixed& operator *= (Fixed rhs) { return *this = *this * rhs; }
+	constexpr Fixed& operator /= (Fixed rhs) { return *this = *this / rhs; }
+
+	constexpr auto operator <=> (const Fixed& rhs) const = default;
+
+};
+
+namespace Math
+{
+	// floor of the square root, bit by bit
+	constexpr uint64_t SquareRoot(uint64_t Value)
+	{
+		uint64_t Remainder	= Value;
+		uint64_t Root		= 0;
+		uint64_t Bit		= uint64_t(1) << 62;
+
+		while (Bit > Remainder)
+			Bit >>= 2;
+
+		while (Bit)
+		{
+			if (Remainder >= Root + Bit)
+			{
+				Remainder	-= Root + Bit;
+				Root		= (Root >> 1) + Bit;
+			}
+			else
+			{
+				Root >>= 1;
+			}
+
+			Bit >>= 2;
+		}
+
+		return Root;
+	}
+
+	// square root of Raw << 16, exact to the last bit
+	constexpr Fixed Sqrt(Fixed Value)
+	{
+		if (Value.Raw <= 0)
+			return Fixed();
+
+		return Fixed::FromRaw(int32_t(SquareRoot(uint64_t(Value.Raw) << Fixed::FractionBits)));
+	}
+
+	// length of (x, y) with the squares summed in 64 bits, x * x alone
+	// saturates past 181 units
+	constexpr Fixed Length(Fixed x, Fixed y)
+	{
+		const uint64_t Squared = uint64_t(int64_t(x.Raw) * x.Raw) + uint64_t(int64_t(y.Raw) * y.Raw);
+
+		return Fixed::FromRaw(Fixed::Saturate(int64_t(SquareRoot(Squared))));
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// per frame numbers for the debug overlay
+
+struct FrameStats
+{
+	double		FrameMs			= 0.0;
+	double		TickMs			= 0.0;
+
+	uint32_t	Entities		= 0;
+	uint32_t	DrawCalls		= 0;
+	uint32_t	CollisionPairs	= 0;
+
+	// refreshed every StorageStatsInterval ticks
+	size_t		StorageBytes	= 0;
+	size_t		PoolBytes		= 0;
+};
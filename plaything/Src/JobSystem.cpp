@@ -0,0 +1,116 @@
+#include "JobSystem.hpp"
+
+JobSystem::JobSystem(uint32_t WorkerCount)
+	: m_Job(nullptr)
+	, m_Count(0)
+	, m_Generation(0)
+	, m_Busy(0)
+	, m_Next(0)
+
+	, m_Quit(false)
+{
+	// the calling thread is a worker too
+	if (WorkerCount > 1)
+		WorkerCount -= 1;
+	else
+		WorkerCount = 0;
+
+	m_Workers.reserve(WorkerCount);
+
+	for (uint32_t i = 0; i < WorkerCount; ++i)
+	{
+		m_Workers.emplace_back(&JobSystem::WorkerLoop, this);
+	}
+}
+
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard Lock(m_Mutex);
+		m_Quit = true;
+	}
+
+	m_WakeCondition.notify_all();
+
+	for (auto& Worker : m_Workers)
+	{
+		Worker.join();
+	}
+}
+
+
+void JobSystem::ParallelFor(uint32_t Count, const std::function<void(uint32_t)>& Job)
+{
+	if (Count == 0)
+		return;
+
+	if (m_Workers.empty() || Count == 1)
+	{
+		for (uint32_t i = 0; i < Count; ++i)
+			Job(i);
+
+		return;
+	}
+
+	{
+		std::lock_guard Lock(m_Mutex);
+
+		m_Job	= &Job;
+		m_Count	= Count;
+		m_Next.store(0, std::memory_order_relaxed);
+		m_Busy	= static_cast<uint32_t>(m_Workers.size());
+
+		++m_Generation;
+	}
+
+	m_WakeCondition.notify_all();
+
+	RunBatch();
+
+	std::unique_lock Lock(m_Mutex);
+	m_DoneCondition.wait(Lock, [this]() { return m_Busy == 0; });
+
+	m_Job = nullptr;
+}
+
+
+void JobSystem::WorkerLoop()
+{
+	uint64_t SeenGeneration = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock Lock(m_Mutex);
+			m_WakeCondition.wait(Lock, [&]() { return m_Quit || m_Generation != SeenGeneration; });
+
+			if (m_Quit)
+				return;
+
+			SeenGeneration = m_Generation;
+		}
+
+		RunBatch();
+
+		{
+			std::lock_guard Lock(m_Mutex);
+			--m_Busy;
+		}
+
+		m_DoneCondition.notify_one();
+	}
+}
+
+
+void JobSystem::RunBatch()
+{
+	// indices are handed out one at a time, jobs are expected to be coarse
+	// (a tile, a chunk of entities) so contention on the counter is negligible
+	for (uint32_t Index = m_Next.fetch_add(1, std::memory_order_relaxed);
+		 Index < m_Count;
+		 Index = m_Next.fetch_add(1, std::memory_order_relaxed))
+	{
+		(*m_Job)(Index);
+	}
+}
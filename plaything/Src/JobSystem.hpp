@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed pool of worker threads for data parallel work.
+// ParallelFor blocks until every index has been processed, the calling
+// thread takes part in the work so nothing idles while it waits.
+
+class JobSystem
+{
+
+public:
+
+	explicit JobSystem(uint32_t WorkerCount = std::thread::hardware_concurrency());
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator = (const JobSystem&) = delete;
+
+
+public:
+
+	void		ParallelFor(uint32_t Count, const std::function<void(uint32_t)>& Job);
+	uint32_t	ThreadCount() const { return static_cast<uint32_t>(m_Workers.size()) + 1; }
+
+
+private:
+
+	void WorkerLoop();
+	void RunBatch();
+
+
+private:
+
+	std::vector<std::thread>			m_Workers;
+
+	std::mutex							m_Mutex;
+	std::condition_variable				m_WakeCondition;
+	std::condition_variable				m_DoneCondition;
+
+	const std::function<void(uint32_t)>*	m_Job;
+	uint32_t							m_Count;
+	uint64_t							m_Generation;
+	uint32_t							m_Busy;
+	std::atomic<uint32_t>				m_Next;
+
+	bool								m_Quit;
+
+};
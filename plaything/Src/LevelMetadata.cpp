@@ -0,0 +1,29 @@
+#include "LevelMetadata.hpp"
+
+#include "Components/AccelerationComponent.hpp"
+#include "Components/ColorComponent.hpp"
+#include "Components/HierarchyComponent.hpp"
+#include "Components/QuadColliderComponent.hpp"
+#include "Components/QuadComponent.hpp"
+#include "Components/SpeedComponent.hpp"
+#include "Components/Tags.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/VelocityComponent.hpp"
+
+void LevelMetadata::Reserve(Registry& Scene) const
+{
+	Scene.storage<entt::entity>().reserve(Entities());
+
+	Scene.storage<TransformComponent>().reserve(Entities());
+	Scene.storage<QuadComponent>().reserve(Entities());
+	Scene.storage<QuadColliderComponent>().reserve(WallTiles + Players + MaxEnemies);
+	Scene.storage<ColorComponent>().reserve(Static() + Attachments);
+	Scene.storage<HierarchyComponent>().reserve(Attachments);
+	Scene.storage<SpeedComponent>().reserve(Players);
+	Scene.storage<VelocityComponent>().reserve(MaxEnemies);
+	Scene.storage<AccelerationComponent>().reserve(MaxEnemies);
+
+	Scene.storage<Tags::Static>().reserve(Static());
+	Scene.storage<Tags::Player>().reserve(Players);
+	Scene.storage<Tags::Enemy>().reserve(MaxEnemies);
+}
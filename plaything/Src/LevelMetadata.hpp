@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Registry.hpp"
+
+#include <cstdint>
+
+// how many of everything a level holds at its peak. Storages are reserved
+// from this up front so spawning mid session never reallocates them.
+
+struct LevelMetadata
+{
+	uint32_t	FloorTiles	= 0;
+	uint32_t	WallTiles	= 0;
+	uint32_t	Players		= 0;
+	uint32_t	MaxEnemies	= 0;
+	uint32_t	Attachments	= 0;	// children in the transform hierarchy
+
+
+	uint32_t	Static()	const { return FloorTiles + WallTiles; }
+	uint32_t	Dynamic()	const { return Players + MaxEnemies + Attachments; }
+	uint32_t	Entities()	const { return Static() + Dynamic(); }
+
+	void Reserve(Registry& Scene) const;
+};
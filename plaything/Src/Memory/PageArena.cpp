@@ -0,0 +1,182 @@
+#include "PageArena.hpp"
+
+#include <bit>
+#include <new>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+#elif defined(__linux__)
+	#include <sys/mman.h>
+#endif
+
+namespace Memory
+{
+	PageArena& PageArena::Get()
+	{
+		static PageArena Arena;
+		return Arena;
+	}
+
+
+	PageArena::PageArena()
+		: m_Reserved(0)
+		, m_Used(0)
+		, m_HugePages(false)
+	{
+
+	}
+
+
+	PageArena::~PageArena()
+	{
+		for (void* Chunk : m_Chunks)
+			UnmapChunk(Chunk, ChunkSize);
+	}
+
+
+	void* PageArena::Allocate(size_t Bytes)
+	{
+		if (Bytes == 0)
+			Bytes = 1;
+
+		std::lock_guard Lock(m_Mutex);
+
+		if (Bytes > ChunkSize)
+		{
+			void* Block = MapChunk(Bytes);
+
+			m_Reserved	+= Bytes;
+			m_Used		+= Bytes;
+
+			return Block;
+		}
+
+		const size_t Class		= ClassOf(Bytes);
+		const size_t BlockSize	= MinBlock << Class;
+
+		auto& Pool = m_Classes[Class];
+
+		m_Used += BlockSize;
+
+		if (Pool.FreeList)
+		{
+			FreeBlock* Block	= Pool.FreeList;
+			Pool.FreeList		= Block->Next;
+
+			return Block;
+		}
+
+		if (Pool.Cursor == Pool.End)
+		{
+			auto* Chunk = static_cast<uint8_t*>(MapChunk(ChunkSize));
+			m_Chunks.push_back(Chunk);
+
+			Pool.Cursor	= Chunk;
+			Pool.End	= Chunk + ChunkSize;
+
+			m_Reserved += ChunkSize;
+		}
+
+		void* Block = Pool.Cursor;
+		Pool.Cursor += BlockSize;
+
+		return Block;
+	}
+
+
+	void PageArena::Deallocate(void* Block, size_t Bytes) noexcept
+	{
+		if (!Block)
+			return;
+
+		if (Bytes == 0)
+			Bytes = 1;
+
+		std::lock_guard Lock(m_Mutex);
+
+		if (Bytes > ChunkSize)
+		{
+			UnmapChunk(Block, Bytes);
+
+			m_Reserved	-= Bytes;
+			m_Used		-= Bytes;
+
+			return;
+		}
+
+		const size_t Class = ClassOf(Bytes);
+
+		auto* Free		= static_cast<FreeBlock*>(Block);
+		Free->Next		= m_Classes[Class].FreeList;
+
+		m_Classes[Class].FreeList = Free;
+
+		m_Used -= MinBlock << Class;
+	}
+
+
+	size_t PageArena::ClassOf(size_t Bytes)
+	{
+		if (Bytes <= MinBlock)
+			return 0;
+
+		return std::bit_width(Bytes - 1) - std::bit_width(MinBlock - 1);
+	}
+
+
+	void* PageArena::MapChunk(size_t Bytes)
+	{
+#if defined(_WIN32)
+		void* Chunk = VirtualAlloc(nullptr, Bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+		if (!Chunk)
+			throw std::bad_alloc();
+
+		return Chunk;
+
+#elif defined(__linux__)
+		// over map so the chunk can be aligned to the huge page size
+		const size_t Mapped = Bytes + ChunkSize;
+
+		void* Raw = mmap(nullptr, Mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (Raw == MAP_FAILED)
+			throw std::bad_alloc();
+
+		const uintptr_t Base	= reinterpret_cast<uintptr_t>(Raw);
+		const uintptr_t Aligned	= (Base + ChunkSize - 1) & ~(uintptr_t(ChunkSize) - 1);
+
+		if (Aligned > Base)
+			munmap(Raw, Aligned - Base);
+
+		if (Base + Mapped > Aligned + Bytes)
+			munmap(reinterpret_cast<void*>(Aligned + Bytes), Base + Mapped - (Aligned + Bytes));
+
+		if (m_HugePages)
+			madvise(reinterpret_cast<void*>(Aligned), Bytes, MADV_HUGEPAGE);
+
+		return reinterpret_cast<void*>(Aligned);
+
+#else
+		return ::operator new(Bytes, std::align_val_t(ChunkSize));
+
+#endif
+	}
+
+
+	void PageArena::UnmapChunk(void* Chunk, size_t Bytes) noexcept
+	{
+#if defined(_WIN32)
+		VirtualFree(Chunk, 0, MEM_RELEASE);
+
+#elif defined(__linux__)
+		munmap(Chunk, Bytes);
+
+#else
+		::operator delete(Chunk, std::align_val_t(ChunkSize));
+
+#endif
+	}
+}
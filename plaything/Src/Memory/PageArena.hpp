@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Memory
+{
+	// process wide page based pool behind PoolAllocator.
+	// requests are rounded up to a power of two size class, every class
+	// carves its blocks out of its own 2 MB chunks and freed blocks go back
+	// to the class free list, so long sessions reuse memory instead of
+	// fragmenting the heap. Requests above a chunk go straight to the os.
+	// Nothing is returned to the os before exit, RSS only ever grows to the
+	// peak of what was in use.
+
+	class PageArena
+	{
+
+	public:
+
+		static constexpr size_t MinBlock	= 64;
+		static constexpr size_t ChunkSize	= size_t(2) << 20;
+
+
+	public:
+
+		static PageArena& Get();
+
+		PageArena(const PageArena&) = delete;
+		PageArena& operator = (const PageArena&) = delete;
+
+
+	public:
+
+		void*	Allocate(size_t Bytes);
+		void	Deallocate(void* Block, size_t Bytes) noexcept;
+
+		// back new chunks with transparent huge pages where the os supports it
+		void	EnableHugePages(bool Enable) { m_HugePages = Enable; }
+
+
+	public:
+
+		size_t	ReservedBytes()	const { return m_Reserved; }
+		size_t	UsedBytes()		const { return m_Used; }
+
+
+	private:
+
+		PageArena();
+		~PageArena();
+
+		static size_t ClassOf(size_t Bytes);
+
+		void*	MapChunk(size_t Bytes);
+		void	UnmapChunk(void* Chunk, size_t Bytes) noexcept;
+
+
+	private:
+
+		static constexpr size_t ClassCount = 16;	// 64 B up to ChunkSize
+
+		struct FreeBlock
+		{
+			FreeBlock* Next;
+		};
+
+		struct SizeClass
+		{
+			FreeBlock*	FreeList	= nullptr;
+			uint8_t*	Cursor		= nullptr;
+			uint8_t*	End			= nullptr;
+		};
+
+
+	private:
+
+		std::mutex				m_Mutex;
+		SizeClass				m_Classes[ClassCount];
+		std::vector<void*>		m_Chunks;
+
+		size_t					m_Reserved;
+		size_t					m_Used;
+		bool					m_HugePages;
+
+	};
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "PageArena.hpp"
+
+#include <cstddef>
+
+namespace Memory
+{
+	// std allocator interface over the PageArena, stateless so every
+	// instance can free what any other one allocated
+
+	template<typename Type>
+	class PoolAllocator
+	{
+
+	public:
+
+		using value_type = Type;
+
+
+	public:
+
+		PoolAllocator() noexcept = default;
+
+		template<typename Other>
+		PoolAllocator(const PoolAllocator<Other>&) noexcept { }
+
+
+	public:
+
+		Type* allocate(size_t Count)
+		{
+			return static_cast<Type*>(PageArena::Get().Allocate(Count * sizeof(Type)));
+		}
+
+		void deallocate(Type* Block, size_t Count) noexcept
+		{
+			PageArena::Get().Deallocate(Block, Count * sizeof(Type));
+		}
+
+
+	public:
+
+		template<typename Other>
+		bool operator == (const PoolAllocator<Other>&) const noexcept { return true; }
+
+	};
+}
@@ -0,0 +1,147 @@
+#include "StorageStats.hpp"
+
+#include "PageArena.hpp"
+
+#include "../Components/AccelerationComponent.hpp"
+#include "../Components/ColorComponent.hpp"
+#include "../Components/HierarchyComponent.hpp"
+#include "../Components/PathComponent.hpp"
+#include "../Components/QuadColliderComponent.hpp"
+#include "../Components/QuadComponent.hpp"
+#include "../Components/SpeedComponent.hpp"
+#include "../Components/Tags.hpp"
+#include "../Components/TransformComponent.hpp"
+#include "../Components/VelocityComponent.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <type_traits>
+
+namespace
+{
+	// sparse sets don't know the size of what they store, every component
+	// with a payload needs to be listed here to have its pages counted
+	using KnownComponents = entt::type_list<
+		Tags::Static,
+		Tags::Player,
+		Tags::Enemy,
+		TransformComponent,
+		QuadComponent,
+		QuadColliderComponent,
+		ColorComponent,
+		SpeedComponent,
+		HierarchyComponent,
+		VelocityComponent,
+		AccelerationComponent,
+		PathComponent>;
+
+	struct Layout
+	{
+		size_t	Size		= 0;
+		size_t	PageSize	= 0;
+	};
+
+	template<typename... Components>
+	Layout LayoutOf(entt::id_type Type, entt::type_list<Components...>)
+	{
+		Layout Found;
+
+		((Type == entt::type_hash<Components>::value()
+			? (void)(Found = Layout{ std::is_empty_v<Components> ? 0 : sizeof(Components), entt::component_traits<Components>::page_size })
+			: (void)0), ...);
+
+		return Found;
+	}
+
+
+	Memory::StorageStats Describe(const Registry::common_type& Storage, std::vector<bool>& Touched)
+	{
+		using Traits = entt::entt_traits<entt::entity>;
+
+		constexpr size_t SparsePage = Traits::page_size;
+
+		Memory::StorageStats Entry;
+
+		Entry.Name			= Storage.type().name();
+		Entry.Entities		= Storage.size();
+		Entry.Capacity		= Storage.capacity();
+		Entry.SparseExtent	= Storage.extent();
+
+		// pages are only allocated when an id in their range is added
+		Touched.assign(Entry.SparseExtent / SparsePage, false);
+
+		for (entt::entity Entity : Storage)
+		{
+			const size_t Page = Traits::to_entity(Entity) / SparsePage;
+
+			if (!Touched[Page])
+			{
+				Touched[Page] = true;
+				Entry.SparsePages++;
+			}
+		}
+
+		const Layout Component = LayoutOf(Storage.type().hash(), KnownComponents{});
+
+		Entry.ComponentSize	= Component.Size;
+		Entry.PackedBytes	= Entry.Capacity * sizeof(entt::entity);
+		Entry.SparseBytes	= Entry.SparsePages * SparsePage * sizeof(entt::entity) + Touched.size() * sizeof(entt::entity*);
+
+		if (Component.Size)
+			Entry.PayloadBytes = (Entry.Capacity + Component.PageSize - 1) / Component.PageSize * Component.PageSize * Component.Size;
+
+		return Entry;
+	}
+}
+
+
+namespace Memory
+{
+	void CollectStorageStats(const Registry& Scene, std::vector<StorageStats>& Stats)
+	{
+		std::vector<bool> Touched;
+
+		Stats.clear();
+
+		// the identifiers live apart from the component pools
+		Stats.push_back(Describe(*Scene.storage<entt::entity>(), Touched));
+
+		for (auto [Id, Storage] : Scene.storage())
+			Stats.push_back(Describe(Storage, Touched));
+	}
+
+
+	void PrintStorageStats(const std::vector<StorageStats>& Stats)
+	{
+		char Line[160]{};
+
+		std::cout << "storage                         entities  capacity  pages  density  component      bytes" << std::endl;
+
+		for (const StorageStats& Entry : Stats)
+		{
+			// type names are long and compiler specific, keep the tail
+			std::string_view Name = Entry.Name.size() > 30 ? Entry.Name.substr(Entry.Name.size() - 30) : Entry.Name;
+
+			snprintf(Line, sizeof(Line), "%-30.*s %9zu %9zu %6zu %7.1f%% %10zu %10zu",
+				int(Name.size()), Name.data(), Entry.Entities, Entry.Capacity, Entry.SparsePages, Entry.Density() * 100.0, Entry.ComponentSize, Entry.Bytes());
+
+			std::cout << Line << std::endl;
+		}
+
+		snprintf(Line, sizeof(Line), "%zu storages, %zu KB, pool %zu KB used of %zu KB reserved",
+			Stats.size(), TotalBytes(Stats) / 1024, PageArena::Get().UsedBytes() / 1024, PageArena::Get().ReservedBytes() / 1024);
+
+		std::cout << Line << std::endl;
+	}
+
+
+	size_t TotalBytes(const std::vector<StorageStats>& Stats)
+	{
+		size_t Bytes = 0;
+
+		for (const StorageStats& Entry : Stats)
+			Bytes += Entry.Bytes();
+
+		return Bytes;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../Registry.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace Memory
+{
+	// what one storage of a registry holds and what it costs.
+	// Bytes are what the storage has allocated, not what is in use, an
+	// entity storage that grew during a wave keeps its capacity after.
+
+	struct StorageStats
+	{
+		std::string_view	Name;
+
+		size_t	Entities		= 0;	// packed size, destroyed ids included for the entity storage
+		size_t	Capacity		= 0;	// packed capacity
+		size_t	SparsePages		= 0;	// sparse pages holding at least one entity
+		size_t	SparseExtent	= 0;	// entity ids the sparse array covers
+		size_t	ComponentSize	= 0;	// 0 for tags and storages of unknown types
+
+		size_t	PackedBytes		= 0;
+		size_t	SparseBytes		= 0;
+		size_t	PayloadBytes	= 0;
+
+
+		size_t	Bytes()		const { return PackedBytes + SparseBytes + PayloadBytes; }
+
+		// how much of the sparse array actually maps to something
+		double	Density()	const { return SparseExtent ? double(Entities) / double(SparseExtent) : 0.0; }
+	};
+
+	// one entry per storage in the registry, Stats is cleared first
+	void CollectStorageStats(const Registry& Scene, std::vector<StorageStats>& Stats);
+
+	// table of everything collected plus totals, to stdout
+	void PrintStorageStats(const std::vector<StorageStats>& Stats);
+
+	size_t TotalBytes(const std::vector<StorageStats>& Stats);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Vector2.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+// Z-order curve. Interleaving the bits of a cell's x and y gives a key where
+// cells close on screen are mostly close in key order, sorting by it puts
+// spatial neighbours next to each other in memory.
+
+namespace Morton
+{
+	// spreads the 16 low bits of Value over the even bits
+	constexpr uint32_t Spread(uint32_t Value)
+	{
+		Value &= 0x0000ffff;
+		Value = (Value | (Value << 8)) & 0x00ff00ff;
+		Value = (Value | (Value << 4)) & 0x0f0f0f0f;
+		Value = (Value | (Value << 2)) & 0x33333333;
+		Value = (Value | (Value << 1)) & 0x55555555;
+
+		return Value;
+	}
+
+	constexpr uint32_t Encode(uint32_t x, uint32_t y)
+	{
+		return Spread(x) | (Spread(y) << 1);
+	}
+
+	// key of the Cell sized grid cell holding Position, clamped to the positive quadrant
+	inline uint32_t Encode(const Vector2& Position, float Cell)
+	{
+		const uint32_t x = uint32_t(std::clamp(Position.x / Cell, 0.0f, 65535.0f));
+		const uint32_t y = uint32_t(std::clamp(Position.y / Cell, 0.0f, 65535.0f));
+
+		return Encode(x, y);
+	}
+}
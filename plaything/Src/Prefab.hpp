@@ -0,0 +1,70 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "Registry.hpp"
+
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+// a component set with default values, defined once and stamped out in bulk.
+// Spawning creates the whole entity range in one go and then fills every
+// storage with one range insert, instead of an emplace per entity per component.
+
+template<typename... Components>
+class Prefab
+{
+
+public:
+
+	explicit Prefab(Components... Defaults)
+		: m_Defaults(std::move(Defaults)...) { }
+
+	~Prefab() = default;
+
+
+public:
+
+	// creates an entity for every slot in [First, Last), all components copied from the defaults
+	// except the ones Values point to, which are copied per entity from those ranges instead,
+	// e.g. a transform and a velocity per spawned entity
+	template<typename It, typename... ValueIts>
+	void Spawn(Registry& Scene, It First, It Last, ValueIts... Values) const
+	{
+		using Overrides = entt::type_list<typename std::iterator_traits<ValueIts>::value_type...>;
+
+		static_assert((entt::type_list_contains_v<entt::type_list<Components...>, typename std::iterator_traits<ValueIts>::value_type> && ...), "Prefab doesn't hold an overridden component");
+
+		Scene.create(First, Last);
+
+		std::apply([&](const Components&... Default) { (Insert<Overrides>(Scene, First, Last, Default, Values...), ...); }, m_Defaults);
+	}
+
+
+public:
+
+	template<typename Type>
+	Type& Default() { return std::get<Type>(m_Defaults); }
+
+	template<typename Type>
+	const Type& Default() const { return std::get<Type>(m_Defaults); }
+
+
+private:
+
+	template<typename Overrides, typename It, typename Type, typename... ValueIts>
+	static void Insert(Registry& Scene, It First, It Last, const Type& Default, ValueIts... Values)
+	{
+		if constexpr (entt::type_list_contains_v<Overrides, Type>)
+			Scene.insert<Type>(First, Last, std::get<entt::type_list_index_v<Type, Overrides>>(std::forward_as_tuple(Values...)));
+		else
+			Scene.insert(First, Last, Default);
+	}
+
+
+private:
+
+	std::tuple<Components...>	m_Defaults;
+
+};
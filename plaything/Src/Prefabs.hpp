@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Components/AccelerationComponent.hpp"
+#include "Components/ColorComponent.hpp"
+#include "Components/HierarchyComponent.hpp"
+#include "Components/QuadColliderComponent.hpp"
+#include "Components/QuadComponent.hpp"
+#include "Components/SpeedComponent.hpp"
+#include "Components/Tags.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/VelocityComponent.hpp"
+
+#include "Prefab.hpp"
+
+#include <cstdint>
+
+// archetypes the level is built from. Positions are almost always given per
+// entity when spawning, the transforms in here are only fallbacks.
+
+namespace Prefabs
+{
+	using FloorPrefab	= Prefab<Tags::Static, TransformComponent, QuadComponent, ColorComponent>;
+	using WallPrefab	= Prefab<Tags::Static, TransformComponent, QuadComponent, QuadColliderComponent, ColorComponent>;
+	using PlayerPrefab	= Prefab<Tags::Player, TransformComponent, QuadComponent, QuadColliderComponent, SpeedComponent>;
+	using EnemyPrefab	= Prefab<Tags::Enemy, TransformComponent, QuadComponent, QuadColliderComponent, VelocityComponent, AccelerationComponent>;
+
+	// follows a parent, spawned with a HierarchyComponent per entity
+	using AttachmentPrefab	= Prefab<TransformComponent, QuadComponent, ColorComponent, HierarchyComponent>;
+
+	inline FloorPrefab Floor(float Size, uint8_t Shade)
+	{
+		return FloorPrefab({}, { 0, 0 }, { Size, Size }, { Shade, Shade, Shade });
+	}
+
+	inline WallPrefab Wall(float Size)
+	{
+		return WallPrefab({}, { 0, 0 }, { Size, Size }, { Size, Size }, { 90, 90, 90 });
+	}
+
+	inline PlayerPrefab Player(float w, float h, float Speed)
+	{
+		return PlayerPrefab({}, { 0, 0 }, { w, h }, { w, h }, { Speed });
+	}
+
+	inline EnemyPrefab Enemy(float w, float h)
+	{
+		return EnemyPrefab({}, { 0, 0 }, { w, h }, { w, h }, {}, {});
+	}
+
+	inline AttachmentPrefab Attachment(float w, float h, uint8_t r, uint8_t g, uint8_t b)
+	{
+		return AttachmentPrefab({ 0, 0 }, { w, h }, { r, g, b }, { entt::null, { 0, 0 } });
+	}
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "Memory/PoolAllocator.hpp"
+
+// registry type of the scene. The allocator is rebound for every storage,
+// so all component storages (and the registry's own bookkeeping) allocate
+// from the PageArena instead of the general purpose heap.
+
+using Registry = entt::basic_registry<entt::entity, Memory::PoolAllocator<entt::entity>>;
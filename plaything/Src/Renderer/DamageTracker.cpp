@@ -0,0 +1,196 @@
+#include "DamageTracker.hpp"
+
+#include "../Components/QuadComponent.hpp"
+
+#include <cmath>
+
+namespace
+{
+	float Area(const SDL_FRect& Rect)
+	{
+		return Rect.w * Rect.h;
+	}
+
+	SDL_FRect Union(const SDL_FRect& A, const SDL_FRect& B)
+	{
+		SDL_FRect Result{};
+		SDL_UnionFRect(&A, &B, &Result);
+
+		return Result;
+	}
+
+	bool Equal(const SDL_FRect& A, const SDL_FRect& B)
+	{
+		return A.x == B.x && A.y == B.y && A.w == B.w && A.h == B.h;
+	}
+}
+
+
+DamageTracker::DamageTracker()
+	: m_Width(0)
+	, m_Height(0)
+{
+
+}
+
+
+void DamageTracker::Connect(Registry& Scene)
+{
+	Scene.on_destroy<QuadComponent>().connect<&DamageTracker::OnDestroy>(this);
+}
+
+
+void DamageTracker::Disconnect(Registry& Scene)
+{
+	Scene.on_destroy<QuadComponent>().disconnect<&DamageTracker::OnDestroy>(this);
+	m_Bounds.clear();
+}
+
+
+void DamageTracker::Resize(int Width, int Height)
+{
+	m_Width		= Width;
+	m_Height	= Height;
+
+	InvalidateAll();
+}
+
+
+void DamageTracker::Track(entt::entity Entity, const SDL_FRect& Bounds)
+{
+	auto [It, Inserted] = m_Bounds.try_emplace(Entity, Bounds);
+
+	if (Inserted)
+	{
+		Invalidate(Bounds);
+	}
+	else if (!Equal(It->second, Bounds))
+	{
+		Invalidate(It->second);
+		Invalidate(Bounds);
+
+		It->second = Bounds;
+	}
+}
+
+
+void DamageTracker::Invalidate(const SDL_FRect& Bounds)
+{
+	if (Bounds.w <= 0.0f || Bounds.h <= 0.0f)
+		return;
+
+	// rects are drawn with an outline, pad by a pixel so rounding never leaves a seam
+	m_Damage.push_back(SDL_FRect{ Bounds.x - 1.0f, Bounds.y - 1.0f, Bounds.w + 2.0f, Bounds.h + 2.0f });
+}
+
+
+void DamageTracker::InvalidateAll()
+{
+	m_Damage.clear();
+	m_Damage.push_back(SDL_FRect{ 0.0f, 0.0f, float(m_Width), float(m_Height) });
+}
+
+
+const std::vector<SDL_Rect>& DamageTracker::Resolve()
+{
+	Merge();
+
+	const SDL_Rect Screen{ 0, 0, m_Width, m_Height };
+
+	m_Dirty.clear();
+
+	for (const auto& Rect : m_Damage)
+	{
+		int x0 = static_cast<int>(std::floor(Rect.x));
+		int y0 = static_cast<int>(std::floor(Rect.y));
+		int x1 = static_cast<int>(std::ceil(Rect.x + Rect.w));
+		int y1 = static_cast<int>(std::ceil(Rect.y + Rect.h));
+
+		SDL_Rect Pixels{ x0, y0, x1 - x0, y1 - y0 };
+		SDL_Rect Clipped{};
+
+		if (SDL_IntersectRect(&Pixels, &Screen, &Clipped) == SDL_TRUE)
+			m_Dirty.push_back(Clipped);
+	}
+
+	m_Damage.clear();
+
+	return m_Dirty;
+}
+
+
+void DamageTracker::OnDestroy(Registry& Scene, entt::entity Entity)
+{
+	if (auto It = m_Bounds.find(Entity); It != m_Bounds.end())
+	{
+		Invalidate(It->second);
+		m_Bounds.erase(It);
+	}
+}
+
+
+void DamageTracker::Merge()
+{
+	// past this point merging costs more than redrawing the bounding box
+	if (m_Damage.size() > MaxPending)
+	{
+		SDL_FRect Bounds = m_Damage.front();
+
+		for (const auto& Rect : m_Damage)
+			Bounds = Union(Bounds, Rect);
+
+		m_Damage.assign(1, Bounds);
+		return;
+	}
+
+	// overlapping rects are always folded together, then the pair that
+	// wastes the least area is merged until the budget is met
+	bool Merged = true;
+
+	while (Merged)
+	{
+		Merged = false;
+
+		for (size_t i = 0; i < m_Damage.size() && !Merged; ++i)
+		{
+			for (size_t j = i + 1; j < m_Damage.size(); ++j)
+			{
+				if (SDL_HasIntersectionF(&m_Damage[i], &m_Damage[j]) == SDL_TRUE)
+				{
+					m_Damage[i] = Union(m_Damage[i], m_Damage[j]);
+					m_Damage[j] = m_Damage.back();
+					m_Damage.pop_back();
+
+					Merged = true;
+					break;
+				}
+			}
+		}
+	}
+
+	while (m_Damage.size() > MaxRects)
+	{
+		size_t	BestI		= 0;
+		size_t	BestJ		= 1;
+		float	BestWaste	= INFINITY;
+
+		for (size_t i = 0; i < m_Damage.size(); ++i)
+		{
+			for (size_t j = i + 1; j < m_Damage.size(); ++j)
+			{
+				float Waste = Area(Union(m_Damage[i], m_Damage[j])) - Area(m_Damage[i]) - Area(m_Damage[j]);
+
+				if (Waste < BestWaste)
+				{
+					BestWaste	= Waste;
+					BestI		= i;
+					BestJ		= j;
+				}
+			}
+		}
+
+		m_Damage[BestI] = Union(m_Damage[BestI], m_Damage[BestJ]);
+		m_Damage[BestJ] = m_Damage.back();
+		m_Damage.pop_back();
+	}
+}
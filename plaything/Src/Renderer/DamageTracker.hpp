@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL2/SDL_rect.h>
+#include <entt/entt.hpp>
+
+#include "../Registry.hpp"
+
+#include <vector>
+
+// records which parts of the screen changed since the last frame.
+// every drawn quad reports its bounds through Track(), when they differ
+// from what was drawn last frame both the old and the new bounds are
+// damaged. Removed quads damage their last bounds through the registry
+// destroy signal. Damage is merged into at most MaxRects dirty rects.
+
+class DamageTracker
+{
+
+public:
+
+	static constexpr size_t MaxRects	= 8;
+	static constexpr size_t MaxPending	= 64;
+
+
+public:
+
+	DamageTracker();
+	~DamageTracker() = default;
+
+
+public:
+
+	void Connect(Registry& Scene);
+	void Disconnect(Registry& Scene);
+
+	void Resize(int Width, int Height);
+
+	void Track(entt::entity Entity, const SDL_FRect& Bounds);
+	void Invalidate(const SDL_FRect& Bounds);
+	void InvalidateAll();
+
+	// merges pending damage into pixel aligned rects and starts a new frame
+	const std::vector<SDL_Rect>& Resolve();
+
+
+private:
+
+	void OnDestroy(Registry& Scene, entt::entity Entity);
+	void Merge();
+
+
+private:
+
+	entt::dense_map<entt::entity, SDL_FRect>	m_Bounds;
+
+	std::vector<SDL_FRect>		m_Damage;
+	std::vector<SDL_Rect>		m_Dirty;
+
+	int							m_Width;
+	int							m_Height;
+
+};
@@ -0,0 +1,169 @@
+#include "DebugOverlay.hpp"
+
+#include "BitmapFont.hpp"
+
+#include "../Logging.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+	// ascii 32 to 127 in a 16x6 grid, with a white texel below for solid fills
+	constexpr int FirstChar		= 32;
+	constexpr int CharCount		= 96;
+	constexpr int Columns		= 16;
+	constexpr int CellW			= BitmapFont::GlyphW + 1;
+	constexpr int CellH			= BitmapFont::GlyphH + 1;
+	constexpr int AtlasW		= Columns * CellW;
+	constexpr int AtlasH		= (CharCount / Columns) * CellH + 1;
+
+	constexpr float WhiteU		= 0.5f / AtlasW;
+	constexpr float WhiteV		= (AtlasH - 0.5f) / AtlasH;
+}
+
+
+DebugOverlay::DebugOverlay()
+	: m_Atlas(nullptr)
+	, m_Dirty(false)
+{
+
+}
+
+
+bool DebugOverlay::Init(SDL_Renderer* Renderer)
+{
+	std::vector<uint32_t> Pixels(size_t(AtlasW) * AtlasH, 0x00FFFFFF);
+
+	for (const auto& Glyph : BitmapFont::Glyphs)
+	{
+		const int Index	= Glyph.Character - FirstChar;
+		const int CellX	= (Index % Columns) * CellW;
+		const int CellY	= (Index / Columns) * CellH;
+
+		for (int y = 0; y < BitmapFont::GlyphH; ++y)
+			for (int x = 0; x < BitmapFont::GlyphW; ++x)
+				if (Glyph.Rows[y] & (1 << (BitmapFont::GlyphW - 1 - x)))
+					Pixels[size_t(CellY + y) * AtlasW + CellX + x] = 0xFFFFFFFF;
+	}
+
+	Pixels[size_t(AtlasH - 1) * AtlasW] = 0xFFFFFFFF;
+
+
+	m_Atlas = SDL_CreateTexture(Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, AtlasW, AtlasH);
+
+	if (!m_Atlas)
+	{
+		DebugLog();
+		return false;
+	}
+
+	SDL_UpdateTexture(m_Atlas, nullptr, Pixels.data(), AtlasW * int(sizeof(uint32_t)));
+	SDL_SetTextureBlendMode(m_Atlas, SDL_BLENDMODE_BLEND);
+	SDL_SetTextureScaleMode(m_Atlas, SDL_ScaleModeNearest);
+
+	m_Lines.reserve(MaxLines);
+
+	return true;
+}
+
+
+void DebugOverlay::Shutdown()
+{
+	if (m_Atlas)
+		SDL_DestroyTexture(m_Atlas);
+
+	m_Atlas = nullptr;
+}
+
+
+void DebugOverlay::SetLine(size_t Index, const char* Text)
+{
+	if (Index >= MaxLines)
+		return;
+
+	if (Index >= m_Lines.size())
+		m_Lines.resize(Index + 1);
+
+	if (m_Lines[Index] == Text)
+		return;
+
+	m_Lines[Index]	= Text;
+	m_Dirty			= true;
+}
+
+
+void DebugOverlay::Render(SDL_Renderer* Renderer)
+{
+	if (!m_Atlas)
+		return;
+
+	if (m_Dirty)
+		Rebuild();
+
+	if (m_Indices.empty())
+		return;
+
+	SDL_RenderGeometry(Renderer, m_Atlas, m_Vertices.data(), int(m_Vertices.size()), m_Indices.data(), int(m_Indices.size()));
+}
+
+
+void DebugOverlay::Rebuild()
+{
+	m_Dirty = false;
+
+	m_Vertices.clear();
+	m_Indices.clear();
+
+	size_t Longest = 0;
+
+	for (const auto& Line : m_Lines)
+		Longest = std::max(Longest, Line.size());
+
+	if (Longest == 0)
+		return;
+
+
+	constexpr float AdvanceX = float(CellW * Scale);
+	constexpr float AdvanceY = float((CellH + 1) * Scale);
+
+	const SDL_FRect Background{ float(Margin), float(Margin), Longest * AdvanceX + 2 * Scale, m_Lines.size() * AdvanceY + 2 * Scale };
+	PushQuad(Background, WhiteU, WhiteV, WhiteU, WhiteV, SDL_Color{ 0, 0, 0, 160 });
+
+
+	for (size_t Row = 0; Row < m_Lines.size(); ++Row)
+	{
+		const float y = Margin + 2 * Scale + Row * AdvanceY;
+
+		for (size_t Column = 0; Column < m_Lines[Row].size(); ++Column)
+		{
+			const int Character = std::toupper(static_cast<unsigned char>(m_Lines[Row][Column]));
+
+			if (Character <= FirstChar || Character >= FirstChar + CharCount)
+				continue;
+
+			const int	Index	= Character - FirstChar;
+			const float	u0		= float((Index % Columns) * CellW) / AtlasW;
+			const float	v0		= float((Index / Columns) * CellH) / AtlasH;
+			const float	u1		= u0 + float(BitmapFont::GlyphW) / AtlasW;
+			const float	v1		= v0 + float(BitmapFont::GlyphH) / AtlasH;
+
+			const SDL_FRect Screen{ Margin + 2 * Scale + Column * AdvanceX, y, float(BitmapFont::GlyphW * Scale), float(BitmapFont::GlyphH * Scale) };
+			PushQuad(Screen, u0, v0, u1, v1, SDL_Color{ 255, 255, 255, 255 });
+		}
+	}
+}
+
+
+void DebugOverlay::PushQuad(const SDL_FRect& Screen, float u0, float v0, float u1, float v1, SDL_Color Color)
+{
+	const int Base = static_cast<int>(m_Vertices.size());
+
+	m_Vertices.push_back(SDL_Vertex{ SDL_FPoint{ Screen.x,				Screen.y },				Color, SDL_FPoint{ u0, v0 } });
+	m_Vertices.push_back(SDL_Vertex{ SDL_FPoint{ Screen.x + Screen.w,	Screen.y },				Color, SDL_FPoint{ u1, v0 } });
+	m_Vertices.push_back(SDL_Vertex{ SDL_FPoint{ Screen.x + Screen.w,	Screen.y + Screen.h },	Color, SDL_FPoint{ u1, v1 } });
+	m_Vertices.push_back(SDL_Vertex{ SDL_FPoint{ Screen.x,				Screen.y + Screen.h },	Color, SDL_FPoint{ u0, v1 } });
+
+	for (int Offset : { 0, 1, 2, 0, 2, 3 })
+		m_Indices.push_back(Base + Offset);
+}
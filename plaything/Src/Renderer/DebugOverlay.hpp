@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <vector>
+
+// text overlay drawn from a glyph atlas baked once from the built in
+// bitmap font. Geometry is only rebuilt when a line changes and the whole
+// overlay, background included, goes out in a single SDL_RenderGeometry call.
+
+class DebugOverlay
+{
+
+public:
+
+	static constexpr int Scale		= 2;
+	static constexpr int Margin		= 8;
+	static constexpr int MaxLines	= 16;
+
+
+public:
+
+	DebugOverlay();
+	~DebugOverlay() = default;
+
+
+public:
+
+	bool Init(SDL_Renderer* Renderer);
+	void Shutdown();
+
+	void SetLine(size_t Index, const char* Text);
+	void Render(SDL_Renderer* Renderer);
+
+
+private:
+
+	void Rebuild();
+	void PushQuad(const SDL_FRect& Screen, float u0, float v0, float u1, float v1, SDL_Color Color);
+
+
+private:
+
+	SDL_Texture*				m_Atlas;
+
+	std::vector<std::string>	m_Lines;
+	bool						m_Dirty;
+
+	std::vector<SDL_Vertex>		m_Vertices;
+	std::vector<int>			m_Indices;
+
+};
@@ -0,0 +1,234 @@
+#include "FrameCapture.hpp"
+
+#include "../Logging.hpp"
+
+#include <SDL2/SDL_image.h>
+
+#include <cstring>
+#include <filesystem>
+
+FrameCapture::FrameCapture()
+	: m_Quit(false)
+{
+	m_Pool.reserve(PoolSize);
+
+	for (size_t i = 0; i < PoolSize; ++i)
+	{
+		m_Pool.push_back(std::make_unique<CaptureImage>());
+		m_Free.push_back(m_Pool.back().get());
+	}
+}
+
+
+FrameCapture::~FrameCapture()
+{
+	Stop();
+}
+
+
+void FrameCapture::Start()
+{
+	if (m_Worker.joinable())
+		return;
+
+	m_Quit		= false;
+	m_Worker	= std::thread(&FrameCapture::WorkerLoop, this);
+}
+
+
+void FrameCapture::Stop()
+{
+	if (!m_Worker.joinable())
+		return;
+
+	// queued frames are still written before the worker exits
+	{
+		std::lock_guard Lock(m_Mutex);
+		m_Quit = true;
+	}
+
+	m_JobCondition.notify_one();
+	m_Worker.join();
+}
+
+
+CaptureImage* FrameCapture::Acquire(int Width, int Height)
+{
+	std::unique_lock Lock(m_Mutex);
+	m_FreeCondition.wait(Lock, [this]() { return !m_Free.empty(); });
+
+	CaptureImage* Image = m_Free.back();
+	m_Free.pop_back();
+
+	Lock.unlock();
+
+	// pooled images keep their capacity, only the first capture at a size allocates
+	Image->Width	= Width;
+	Image->Height	= Height;
+	Image->Pixels.resize(size_t(Width) * Height);
+
+	return Image;
+}
+
+
+void FrameCapture::Release(CaptureImage* Image)
+{
+	{
+		std::lock_guard Lock(m_Mutex);
+		m_Free.push_back(Image);
+	}
+
+	m_FreeCondition.notify_one();
+}
+
+
+void FrameCapture::Submit(CaptureImage* Image, std::string Path, CaptureFormat Format)
+{
+	{
+		std::lock_guard Lock(m_Mutex);
+		m_Jobs.push_back(Job{ Image, std::move(Path), Format });
+	}
+
+	m_JobCondition.notify_one();
+}
+
+
+bool FrameCapture::ReadRenderer(SDL_Renderer* Renderer, CaptureImage& Image)
+{
+	if (SDL_RenderReadPixels(Renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, Image.Pixels.data(), Image.Width * int(sizeof(uint32_t))) != 0)
+	{
+		DebugLog();
+		return false;
+	}
+
+	return true;
+}
+
+
+void FrameCapture::ReadPixels(const uint32_t* Pixels, int Pitch, CaptureImage& Image)
+{
+	const size_t RowBytes = size_t(Image.Width) * sizeof(uint32_t);
+
+	for (int y = 0; y < Image.Height; ++y)
+	{
+		const auto* Row = reinterpret_cast<const uint8_t*>(Pixels) + size_t(y) * Pitch;
+		std::memcpy(&Image.Pixels[size_t(y) * Image.Width], Row, RowBytes);
+	}
+}
+
+
+bool FrameCapture::Encode(const CaptureImage& Image, const std::string& Path, CaptureFormat Format)
+{
+	if (Format == CaptureFormat::Raw)
+	{
+		SDL_RWops* File = SDL_RWFromFile(Path.c_str(), "wb");
+
+		if (!File)
+		{
+			DebugLog();
+			return false;
+		}
+
+		const size_t Written = SDL_RWwrite(File, Image.Pixels.data(), sizeof(uint32_t), Image.Pixels.size());
+		SDL_RWclose(File);
+
+		return Written == Image.Pixels.size();
+	}
+
+	SDL_Surface* Surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<uint32_t*>(Image.Pixels.data()),
+															  Image.Width,
+															  Image.Height,
+															  32,
+															  Image.Width * int(sizeof(uint32_t)),
+															  SDL_PIXELFORMAT_ARGB8888);
+
+	if (!Surface)
+	{
+		DebugLog();
+		return false;
+	}
+
+	const bool Saved = IMG_SavePNG(Surface, Path.c_str()) == 0;
+
+	if (!Saved)
+	{
+		DebugLog();
+	}
+
+	SDL_FreeSurface(Surface);
+
+	return Saved;
+}
+
+
+int64_t FrameCapture::CompareGolden(const CaptureImage& Image, const std::string& Path)
+{
+	std::error_code Error;
+
+	if (!std::filesystem::exists(Path, Error) && !Error)
+		return GoldenMissing;
+
+	SDL_Surface* Loaded = IMG_Load(Path.c_str());
+
+	if (!Loaded)
+	{
+		DebugLog();
+		return GoldenUnreadable;
+	}
+
+	SDL_Surface* Golden = SDL_ConvertSurfaceFormat(Loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+	SDL_FreeSurface(Loaded);
+
+	if (!Golden)
+	{
+		DebugLog();
+		return GoldenUnreadable;
+	}
+
+	if (Golden->w != Image.Width || Golden->h != Image.Height)
+	{
+		SDL_FreeSurface(Golden);
+		return GoldenUnreadable;
+	}
+
+	int64_t Mismatched = 0;
+
+	for (int y = 0; y < Image.Height; ++y)
+	{
+		const auto* GoldenRow	= reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(Golden->pixels) + size_t(y) * Golden->pitch);
+		const auto* ImageRow	= &Image.Pixels[size_t(y) * Image.Width];
+
+		for (int x = 0; x < Image.Width; ++x)
+		{
+			if ((GoldenRow[x] ^ ImageRow[x]) & 0x00FFFFFF)
+				++Mismatched;
+		}
+	}
+
+	SDL_FreeSurface(Golden);
+
+	return Mismatched;
+}
+
+
+void FrameCapture::WorkerLoop()
+{
+	while (true)
+	{
+		Job Next{};
+
+		{
+			std::unique_lock Lock(m_Mutex);
+			m_JobCondition.wait(Lock, [this]() { return m_Quit || !m_Jobs.empty(); });
+
+			if (m_Jobs.empty())
+				return;
+
+			Next = std::move(m_Jobs.front());
+			m_Jobs.pop_front();
+		}
+
+		Encode(*Next.Image, Next.Path, Next.Format);
+		Release(Next.Image);
+	}
+}
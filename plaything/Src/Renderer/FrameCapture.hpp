@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// frame readback and encoding off the main loop.
+// pixels are copied into a pooled image on the render thread, encoding and
+// disk io happen on a worker. When every pooled image is still in flight
+// Acquire() waits, so long dumps apply backpressure instead of dropping frames.
+
+enum class CaptureFormat
+{
+	PNG,
+	Raw,	// ARGB8888 rows, no header
+};
+
+
+struct CaptureImage
+{
+	std::vector<uint32_t>	Pixels;		// ARGB8888, tightly packed
+	int						Width;
+	int						Height;
+};
+
+
+class FrameCapture
+{
+
+public:
+
+	static constexpr size_t PoolSize = 4;
+
+	static constexpr int64_t GoldenMissing		= -1;
+	static constexpr int64_t GoldenUnreadable	= -2;
+
+
+public:
+
+	FrameCapture();
+	~FrameCapture();
+
+	FrameCapture(const FrameCapture&) = delete;
+	FrameCapture& operator = (const FrameCapture&) = delete;
+
+
+public:
+
+	void Start();
+	void Stop();
+
+	CaptureImage*	Acquire(int Width, int Height);
+	void			Release(CaptureImage* Image);
+
+	// hands the image to the worker, it is released once encoded
+	void Submit(CaptureImage* Image, std::string Path, CaptureFormat Format);
+
+
+public:
+
+	static bool ReadRenderer(SDL_Renderer* Renderer, CaptureImage& Image);
+	static void ReadPixels(const uint32_t* Pixels, int Pitch, CaptureImage& Image);
+
+	static bool Encode(const CaptureImage& Image, const std::string& Path, CaptureFormat Format);
+
+	// number of pixels whose color differs from the golden image, alpha is ignored.
+	// GoldenMissing when there is no file at Path, GoldenUnreadable when it
+	// can't be decoded or has another size.
+	static int64_t CompareGolden(const CaptureImage& Image, const std::string& Path);
+
+
+private:
+
+	struct Job
+	{
+		CaptureImage*	Image;
+		std::string		Path;
+		CaptureFormat	Format;
+	};
+
+
+private:
+
+	void WorkerLoop();
+
+
+private:
+
+	std::vector<std::unique_ptr<CaptureImage>>	m_Pool;
+	std::vector<CaptureImage*>					m_Free;
+
+	std::deque<Job>				m_Jobs;
+
+	std::mutex					m_Mutex;
+	std::condition_variable		m_JobCondition;
+	std::condition_variable		m_FreeCondition;
+
+	std::thread					m_Worker;
+	bool						m_Quit;
+
+};
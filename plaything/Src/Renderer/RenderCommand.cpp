@@ -0,0 +1,45 @@
+#include "RenderCommand.hpp"
+
+void RenderCommandList::Quad(const SDL_FRect& Rect, uint32_t Flags, uint32_t Id)
+{
+	auto& Command = m_Commands.emplace_back();
+
+	Command.Type = RenderCommandType::Quad;
+	Command.Quad = QuadCommand{ Rect, Flags, Id };
+}
+
+
+void RenderCommandList::Sprite(SDL_Texture* Texture, const SDL_Rect& Source, const SDL_FRect& Destination)
+{
+	auto& Command = m_Commands.emplace_back();
+
+	Command.Type	= RenderCommandType::Sprite;
+	Command.Sprite	= SpriteCommand{ Texture, Source, Destination };
+}
+
+
+void RenderCommandList::Line(float x0, float y0, float x1, float y1)
+{
+	auto& Command = m_Commands.emplace_back();
+
+	Command.Type = RenderCommandType::Line;
+	Command.Line = LineCommand{ x0, y0, x1, y1 };
+}
+
+
+void RenderCommandList::Clip(const SDL_Rect& Rect)
+{
+	auto& Command = m_Commands.emplace_back();
+
+	Command.Type = RenderCommandType::Clip;
+	Command.Clip = ClipCommand{ Rect };
+}
+
+
+void RenderCommandList::Color(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+	auto& Command = m_Commands.emplace_back();
+
+	Command.Type	= RenderCommandType::State;
+	Command.State	= StateCommand{ SDL_Color{ r, g, b, a } };
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <SDL2/SDL_pixels.h>
+#include <SDL2/SDL_rect.h>
+#include <SDL2/SDL_render.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// compact render command stream.
+// commands are plain data so a frame can be built on any thread, copied
+// around or dumped to disk and replayed against a backend later.
+
+enum class RenderCommandType : uint8_t
+{
+	Quad,
+	Sprite,
+	Line,
+	Clip,
+	State,
+};
+
+
+enum QuadFlags : uint32_t
+{
+	QuadFill	= 1 << 0,
+	QuadOutline	= 1 << 1,
+};
+
+
+struct QuadCommand
+{
+	SDL_FRect	Rect;
+	uint32_t	Flags;
+	uint32_t	Id;			// entity the quad belongs to, used for damage tracking
+};
+
+
+struct SpriteCommand
+{
+	SDL_Texture*	Texture;
+	SDL_Rect		Source;		// empty source samples the whole texture
+	SDL_FRect		Destination;
+};
+
+
+struct LineCommand
+{
+	float x0, y0;
+	float x1, y1;
+};
+
+
+struct ClipCommand
+{
+	SDL_Rect	Rect;		// empty rect disables clipping
+};
+
+
+struct StateCommand
+{
+	SDL_Color	Color;
+};
+
+
+struct RenderCommand
+{
+	RenderCommandType Type;
+
+	union
+	{
+		QuadCommand		Quad;
+		SpriteCommand	Sprite;
+		LineCommand		Line;
+		ClipCommand		Clip;
+		StateCommand	State;
+	};
+};
+
+static_assert(std::is_trivially_copyable_v<RenderCommand>, "render commands must stay plain data");
+
+
+class RenderCommandList
+{
+
+public:
+
+	void Clear() { m_Commands.clear(); }
+	void Reserve(size_t Count) { m_Commands.reserve(Count); }
+
+	void Quad(const SDL_FRect& Rect, uint32_t Flags, uint32_t Id);
+	void Sprite(SDL_Texture* Texture, const SDL_Rect& Source, const SDL_FRect& Destination);
+	void Line(float x0, float y0, float x1, float y1);
+	void Clip(const SDL_Rect& Rect);
+	void Color(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+
+public:
+
+	const RenderCommand*	begin()	const { return m_Commands.data(); }
+	const RenderCommand*	end()	const { return m_Commands.data() + m_Commands.size(); }
+	size_t					size()	const { return m_Commands.size(); }
+
+
+private:
+
+	std::vector<RenderCommand> m_Commands;
+
+};
+
+
+// two command lists, one being recorded while the other one is executed
+
+class RenderCommandBuffer
+{
+
+public:
+
+	RenderCommandBuffer() : m_Write(0) { }
+
+
+public:
+
+	RenderCommandList&			Record()			{ m_Lists[m_Write].Clear(); return m_Lists[m_Write]; }
+	const RenderCommandList&	Commands()	const	{ return m_Lists[m_Write ^ 1]; }
+
+	void Swap() { m_Write ^= 1; }
+
+
+private:
+
+	RenderCommandList	m_Lists[2];
+	uint32_t			m_Write;
+
+};
@@ -0,0 +1,113 @@
+#include "SDLRenderBackend.hpp"
+
+#include "RenderCommand.hpp"
+
+SDLRenderBackend::SDLRenderBackend()
+	: m_Renderer(nullptr)
+	, m_DrawCalls(0)
+{
+
+}
+
+
+void SDLRenderBackend::Execute(const RenderCommandList& Commands, const SDL_Rect* Region)
+{
+	SDL_FRect Bounds{};
+
+	if (Region)
+	{
+		Bounds = SDL_FRect{ float(Region->x), float(Region->y), float(Region->w), float(Region->h) };
+		SDL_RenderSetClipRect(m_Renderer, Region);
+	}
+
+	for (const auto& Command : Commands)
+	{
+		switch (Command.Type)
+		{
+			case RenderCommandType::Quad:
+			{
+				const auto& Quad = Command.Quad;
+
+				if (Region && SDL_HasIntersectionF(&Quad.Rect, &Bounds) == SDL_FALSE)
+					break;
+
+				if (Quad.Flags & QuadFill)
+				{
+					SDL_RenderFillRectF(m_Renderer, &Quad.Rect);
+					++m_DrawCalls;
+				}
+
+				if (Quad.Flags & QuadOutline)
+				{
+					SDL_RenderDrawRectF(m_Renderer, &Quad.Rect);
+					++m_DrawCalls;
+				}
+
+				break;
+			}
+
+			case RenderCommandType::Sprite:
+			{
+				const auto& Sprite = Command.Sprite;
+
+				if (Region && SDL_HasIntersectionF(&Sprite.Destination, &Bounds) == SDL_FALSE)
+					break;
+
+				const SDL_Rect* Source = SDL_RectEmpty(&Sprite.Source) ? nullptr : &Sprite.Source;
+				SDL_RenderCopyF(m_Renderer, Sprite.Texture, Source, &Sprite.Destination);
+				++m_DrawCalls;
+
+				break;
+			}
+
+			case RenderCommandType::Line:
+			{
+				const auto& Line = Command.Line;
+				SDL_RenderDrawLineF(m_Renderer, Line.x0, Line.y0, Line.x1, Line.y1);
+				++m_DrawCalls;
+
+				break;
+			}
+
+			case RenderCommandType::Clip:
+			{
+				ApplyClip(Command.Clip.Rect, Region);
+				break;
+			}
+
+			case RenderCommandType::State:
+			{
+				const auto& Color = Command.State.Color;
+				SDL_SetRenderDrawColor(m_Renderer, Color.r, Color.g, Color.b, Color.a);
+
+				break;
+			}
+		}
+	}
+
+	SDL_RenderSetClipRect(m_Renderer, nullptr);
+}
+
+
+void SDLRenderBackend::ApplyClip(const SDL_Rect& Clip, const SDL_Rect* Region)
+{
+	if (SDL_RectEmpty(&Clip))
+	{
+		SDL_RenderSetClipRect(m_Renderer, Region);
+		return;
+	}
+
+	if (!Region)
+	{
+		SDL_RenderSetClipRect(m_Renderer, &Clip);
+		return;
+	}
+
+	SDL_Rect Combined{};
+
+	// nothing of this clip is inside the region, clip everything away
+	if (SDL_IntersectRect(&Clip, Region, &Combined) == SDL_FALSE)
+		Combined = SDL_Rect{ Region->x, Region->y, 0, 0 };
+
+	SDL_RenderSetClipRect(m_Renderer, &Combined);
+}
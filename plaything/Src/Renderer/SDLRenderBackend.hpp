@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+class RenderCommandList;
+
+// executes a render command stream through SDL_Renderer
+
+class SDLRenderBackend
+{
+
+public:
+
+	SDLRenderBackend();
+	~SDLRenderBackend() = default;
+
+
+public:
+
+	void SetRenderer(SDL_Renderer* Renderer) { m_Renderer = Renderer; }
+
+	// with a region everything is clipped to it and commands entirely
+	// outside of it are skipped, used to redraw damaged parts of a frame
+	void Execute(const RenderCommandList& Commands, const SDL_Rect* Region = nullptr);
+
+	// SDL draw calls issued since the last reset
+	uint32_t	DrawCalls() const	{ return m_DrawCalls; }
+	void		ResetStats()		{ m_DrawCalls = 0; }
+
+
+private:
+
+	void ApplyClip(const SDL_Rect& Clip, const SDL_Rect* Region);
+
+
+private:
+
+	SDL_Renderer*	m_Renderer;
+	uint32_t		m_DrawCalls;
+
+};
@@ -0,0 +1,287 @@
+#include "SoftwareRasterizer.hpp"
+
+#include "RenderCommand.hpp"
+
+#include "../JobSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// matches SDL_PIXELFORMAT_ARGB8888 so the framebuffer can be uploaded as is
+	constexpr uint32_t PackColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+	{
+		return (uint32_t(a) << 24) | (uint32_t(r) << 16) | (uint32_t(g) << 8) | uint32_t(b);
+	}
+}
+
+
+SoftwareRasterizer::SoftwareRasterizer()
+	: m_Width(0)
+	, m_Height(0)
+
+	, m_TilesX(0)
+	, m_TilesY(0)
+
+	, m_ClearColor(PackColor(0, 0, 0, 255))
+	, m_DrawColor(PackColor(255, 255, 255, 255))
+
+	, m_Clip{ 0, 0, 0, 0 }
+
+	, m_Flushed(0)
+{
+
+}
+
+
+void SoftwareRasterizer::Resize(uint32_t Width, uint32_t Height)
+{
+	m_Width		= Width;
+	m_Height	= Height;
+
+	m_TilesX	= (Width  + TileSize - 1) / TileSize;
+	m_TilesY	= (Height + TileSize - 1) / TileSize;
+
+	m_Clip		= SDL_Rect{ 0, 0, int(Width), int(Height) };
+
+	m_Framebuffer.assign(size_t(Width) * Height, m_ClearColor);
+	m_BinOffsets.assign(size_t(m_TilesX) * m_TilesY + 1, 0);
+}
+
+
+void SoftwareRasterizer::Clear(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+	// clearing is deferred to the tile pass, anything queued before is dropped
+	m_ClearColor = PackColor(r, g, b, a);
+	m_Primitives.clear();
+}
+
+
+void SoftwareRasterizer::SetDrawColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+	m_DrawColor = PackColor(r, g, b, a);
+}
+
+
+void SoftwareRasterizer::FillRect(const SDL_FRect& Quad)
+{
+	PushPrimitive(static_cast<int32_t>(std::lround(Quad.x)),
+				  static_cast<int32_t>(std::lround(Quad.y)),
+				  static_cast<int32_t>(std::lround(Quad.x + Quad.w)),
+				  static_cast<int32_t>(std::lround(Quad.y + Quad.h)));
+}
+
+
+void SoftwareRasterizer::DrawRect(const SDL_FRect& Quad)
+{
+	int32_t x0 = static_cast<int32_t>(std::lround(Quad.x));
+	int32_t y0 = static_cast<int32_t>(std::lround(Quad.y));
+	int32_t x1 = static_cast<int32_t>(std::lround(Quad.x + Quad.w));
+	int32_t y1 = static_cast<int32_t>(std::lround(Quad.y + Quad.h));
+
+	// outline as four one pixel wide spans
+	PushPrimitive(x0,		y0,		x1,		y0 + 1);
+	PushPrimitive(x0,		y1 - 1,	x1,		y1);
+	PushPrimitive(x0,		y0,		x0 + 1,	y1);
+	PushPrimitive(x1 - 1,	y0,		x1,		y1);
+}
+
+
+void SoftwareRasterizer::DrawLine(float x0, float y0, float x1, float y1)
+{
+	// bresenham, consecutive pixels along the major axis are pushed as one span
+	int32_t x	= static_cast<int32_t>(std::lround(x0));
+	int32_t y	= static_cast<int32_t>(std::lround(y0));
+	int32_t xe	= static_cast<int32_t>(std::lround(x1));
+	int32_t ye	= static_cast<int32_t>(std::lround(y1));
+
+	const int32_t dx = std::abs(xe - x);
+	const int32_t dy = -std::abs(ye - y);
+	const int32_t sx = x < xe ? 1 : -1;
+	const int32_t sy = y < ye ? 1 : -1;
+
+	const bool XMajor = dx >= -dy;
+
+	int32_t Error	= dx + dy;
+	int32_t SpanX	= x;
+	int32_t SpanY	= y;
+	int32_t LastX	= x;
+	int32_t LastY	= y;
+
+	auto PushSpan = [this](int32_t ax, int32_t ay, int32_t bx, int32_t by)
+	{
+		PushPrimitive(std::min(ax, bx), std::min(ay, by), std::max(ax, bx) + 1, std::max(ay, by) + 1);
+	};
+
+	while (x != xe || y != ye)
+	{
+		const int32_t Error2 = 2 * Error;
+
+		if (Error2 >= dy) { Error += dy; x += sx; }
+		if (Error2 <= dx) { Error += dx; y += sy; }
+
+		// the span ends whenever the minor axis moves
+		if (XMajor ? y != LastY : x != LastX)
+		{
+			PushSpan(SpanX, SpanY, LastX, LastY);
+
+			SpanX = x;
+			SpanY = y;
+		}
+
+		LastX = x;
+		LastY = y;
+	}
+
+	PushSpan(SpanX, SpanY, LastX, LastY);
+}
+
+
+void SoftwareRasterizer::SetClipRect(const SDL_Rect* Clip)
+{
+	if (!Clip)
+	{
+		m_Clip = SDL_Rect{ 0, 0, int(m_Width), int(m_Height) };
+		return;
+	}
+
+	m_Clip = *Clip;
+}
+
+
+void SoftwareRasterizer::Execute(const RenderCommandList& Commands)
+{
+	for (const auto& Command : Commands)
+	{
+		switch (Command.Type)
+		{
+			case RenderCommandType::Quad:
+			{
+				if (Command.Quad.Flags & QuadFill)
+					FillRect(Command.Quad.Rect);
+
+				if (Command.Quad.Flags & QuadOutline)
+					DrawRect(Command.Quad.Rect);
+
+				break;
+			}
+
+			case RenderCommandType::Line:
+			{
+				const auto& Line = Command.Line;
+				DrawLine(Line.x0, Line.y0, Line.x1, Line.y1);
+
+				break;
+			}
+
+			case RenderCommandType::Clip:
+			{
+				SetClipRect(SDL_RectEmpty(&Command.Clip.Rect) ? nullptr : &Command.Clip.Rect);
+				break;
+			}
+
+			case RenderCommandType::State:
+			{
+				const auto& Color = Command.State.Color;
+				SetDrawColor(Color.r, Color.g, Color.b, Color.a);
+
+				break;
+			}
+
+			case RenderCommandType::Sprite:
+				break;
+		}
+	}
+
+	SetClipRect(nullptr);
+}
+
+
+void SoftwareRasterizer::Flush(JobSystem& Jobs)
+{
+	BinPrimitives();
+
+	Jobs.ParallelFor(m_TilesX * m_TilesY, [this](uint32_t Tile) { RasterizeTile(Tile); });
+
+	m_Flushed = static_cast<uint32_t>(m_Primitives.size());
+	m_Primitives.clear();
+}
+
+
+void SoftwareRasterizer::PushPrimitive(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+	x0 = std::max({ x0, 0, m_Clip.x });
+	y0 = std::max({ y0, 0, m_Clip.y });
+	x1 = std::min({ x1, static_cast<int32_t>(m_Width),  m_Clip.x + m_Clip.w });
+	y1 = std::min({ y1, static_cast<int32_t>(m_Height), m_Clip.y + m_Clip.h });
+
+	if (x0 >= x1 || y0 >= y1)
+		return;
+
+	m_Primitives.push_back(Primitive{ x0, y0, x1, y1, m_DrawColor });
+}
+
+
+void SoftwareRasterizer::BinPrimitives()
+{
+	// counting sort into tiles, iterating primitives in submission order
+	// keeps draw order inside every bin
+	std::fill(m_BinOffsets.begin(), m_BinOffsets.end(), 0);
+
+	for (const auto& Prim : m_Primitives)
+	{
+		for (int32_t ty = Prim.y0 / TileSize; ty <= (Prim.y1 - 1) / TileSize; ++ty)
+			for (int32_t tx = Prim.x0 / TileSize; tx <= (Prim.x1 - 1) / TileSize; ++tx)
+				++m_BinOffsets[ty * m_TilesX + tx + 1];
+	}
+
+	for (size_t i = 1; i < m_BinOffsets.size(); ++i)
+	{
+		m_BinOffsets[i] += m_BinOffsets[i - 1];
+	}
+
+	m_BinItems.resize(m_BinOffsets.back());
+
+	m_BinCursor.assign(m_BinOffsets.begin(), m_BinOffsets.end() - 1);
+
+	for (uint32_t Index = 0; Index < m_Primitives.size(); ++Index)
+	{
+		const auto& Prim = m_Primitives[Index];
+
+		for (int32_t ty = Prim.y0 / TileSize; ty <= (Prim.y1 - 1) / TileSize; ++ty)
+			for (int32_t tx = Prim.x0 / TileSize; tx <= (Prim.x1 - 1) / TileSize; ++tx)
+				m_BinItems[m_BinCursor[ty * m_TilesX + tx]++] = Index;
+	}
+}
+
+
+void SoftwareRasterizer::RasterizeTile(uint32_t Tile)
+{
+	const int32_t TileX0 = static_cast<int32_t>(Tile % m_TilesX) * TileSize;
+	const int32_t TileY0 = static_cast<int32_t>(Tile / m_TilesX) * TileSize;
+	const int32_t TileX1 = std::min(TileX0 + TileSize, static_cast<int32_t>(m_Width));
+	const int32_t TileY1 = std::min(TileY0 + TileSize, static_cast<int32_t>(m_Height));
+
+	for (int32_t y = TileY0; y < TileY1; ++y)
+	{
+		uint32_t* Row = &m_Framebuffer[size_t(y) * m_Width];
+		std::fill(Row + TileX0, Row + TileX1, m_ClearColor);
+	}
+
+	for (uint32_t i = m_BinOffsets[Tile]; i < m_BinOffsets[Tile + 1]; ++i)
+	{
+		const auto& Prim = m_Primitives[m_BinItems[i]];
+
+		const int32_t x0 = std::max(Prim.x0, TileX0);
+		const int32_t y0 = std::max(Prim.y0, TileY0);
+		const int32_t x1 = std::min(Prim.x1, TileX1);
+		const int32_t y1 = std::min(Prim.y1, TileY1);
+
+		for (int32_t y = y0; y < y1; ++y)
+		{
+			uint32_t* Row = &m_Framebuffer[size_t(y) * m_Width];
+			std::fill(Row + x0, Row + x1, Prim.Color);
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <SDL2/SDL_rect.h>
+
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+class RenderCommandList;
+
+// CPU rasterizer for the software render path.
+// Primitives are queued for the whole frame, then Flush() bins them into
+// screen tiles and every tile is filled by a worker thread. A tile only
+// ever gets touched by one thread, and its bin keeps submission order, so
+// the output matches drawing everything in order on a single core.
+
+class SoftwareRasterizer
+{
+
+public:
+
+	static constexpr int32_t TileSize = 64;
+
+
+public:
+
+	SoftwareRasterizer();
+	~SoftwareRasterizer() = default;
+
+
+public:
+
+	void Resize(uint32_t Width, uint32_t Height);
+
+	void Clear(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+	void SetDrawColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+	void FillRect(const SDL_FRect& Quad);
+	void DrawRect(const SDL_FRect& Quad);
+	void DrawLine(float x0, float y0, float x1, float y1);
+	void SetClipRect(const SDL_Rect* Clip);
+
+	// sprites reference gpu textures and are skipped
+	void Execute(const RenderCommandList& Commands);
+
+	void Flush(JobSystem& Jobs);
+
+
+public:
+
+	const uint32_t*	Pixels()	const { return m_Framebuffer.data(); }
+	int				Pitch()		const { return static_cast<int>(m_Width * sizeof(uint32_t)); }
+	uint32_t		Width()		const { return m_Width; }
+	uint32_t		Height()	const { return m_Height; }
+
+	// primitives rasterized by the last Flush()
+	uint32_t		Primitives() const { return m_Flushed; }
+
+
+private:
+
+	// pixel bounds are half open, [x0, x1) x [y0, y1)
+	struct Primitive
+	{
+		int32_t		x0, y0;
+		int32_t		x1, y1;
+		uint32_t	Color;
+	};
+
+
+private:
+
+	void PushPrimitive(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+	void BinPrimitives();
+	void RasterizeTile(uint32_t Tile);
+
+
+private:
+
+	std::vector<uint32_t>	m_Framebuffer;
+	uint32_t				m_Width;
+	uint32_t				m_Height;
+
+	uint32_t				m_TilesX;
+	uint32_t				m_TilesY;
+
+	uint32_t				m_ClearColor;
+	uint32_t				m_DrawColor;
+
+	SDL_Rect				m_Clip;
+
+	std::vector<Primitive>	m_Primitives;
+	uint32_t				m_Flushed;
+
+	// bins are stored flat, tile i owns m_BinItems[m_BinOffsets[i], m_BinOffsets[i + 1])
+	std::vector<uint32_t>	m_BinOffsets;
+	std::vector<uint32_t>	m_BinItems;
+	std::vector<uint32_t>	m_BinCursor;
+
+};
@@ -0,0 +1,253 @@
+#include "StaticLayer.hpp"
+
+#include "SDLRenderBackend.hpp"
+
+#include "../Components/ColorComponent.hpp"
+#include "../Components/QuadComponent.hpp"
+#include "../Components/Tags.hpp"
+#include "../Components/TransformComponent.hpp"
+
+#include "../Logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+StaticLayer::StaticLayer()
+	: m_Renderer(nullptr)
+
+	, m_ChunksX(0)
+	, m_ChunksY(0)
+	, m_Dirty(false)
+{
+
+}
+
+
+void StaticLayer::Init(SDL_Renderer* Renderer, int Width, int Height)
+{
+	m_Renderer	= Renderer;
+
+	m_ChunksX	= (Width  + ChunkSize - 1) / ChunkSize;
+	m_ChunksY	= (Height + ChunkSize - 1) / ChunkSize;
+
+	// textures are created the first time a chunk has something in it
+	m_Chunks.assign(size_t(m_ChunksX) * m_ChunksY, Chunk{ nullptr, true, true });
+	m_ChunkCommands.resize(m_Chunks.size());
+
+	m_Dirty = true;
+}
+
+
+void StaticLayer::Shutdown()
+{
+	for (auto& Chunk : m_Chunks)
+	{
+		if (Chunk.Texture)
+			SDL_DestroyTexture(Chunk.Texture);
+	}
+
+	m_Chunks.clear();
+	m_ChunkCommands.clear();
+	m_Bounds.clear();
+
+	m_Renderer = nullptr;
+}
+
+
+void StaticLayer::Connect(Registry& Scene)
+{
+	Scene.on_construct<TransformComponent>().connect<&StaticLayer::OnChanged>(this);
+	Scene.on_update<TransformComponent>().connect<&StaticLayer::OnChanged>(this);
+	Scene.on_destroy<TransformComponent>().connect<&StaticLayer::OnRemoved>(this);
+
+	Scene.on_construct<QuadComponent>().connect<&StaticLayer::OnChanged>(this);
+	Scene.on_update<QuadComponent>().connect<&StaticLayer::OnChanged>(this);
+	Scene.on_destroy<QuadComponent>().connect<&StaticLayer::OnRemoved>(this);
+
+	Scene.on_construct<Tags::Static>().connect<&StaticLayer::OnChanged>(this);
+	Scene.on_destroy<Tags::Static>().connect<&StaticLayer::OnRemoved>(this);
+}
+
+
+void StaticLayer::Disconnect(Registry& Scene)
+{
+	Scene.on_construct<TransformComponent>().disconnect<&StaticLayer::OnChanged>(this);
+	Scene.on_update<TransformComponent>().disconnect<&StaticLayer::OnChanged>(this);
+	Scene.on_destroy<TransformComponent>().disconnect<&StaticLayer::OnRemoved>(this);
+
+	Scene.on_construct<QuadComponent>().disconnect<&StaticLayer::OnChanged>(this);
+	Scene.on_update<QuadComponent>().disconnect<&StaticLayer::OnChanged>(this);
+	Scene.on_destroy<QuadComponent>().disconnect<&StaticLayer::OnRemoved>(this);
+
+	Scene.on_construct<Tags::Static>().disconnect<&StaticLayer::OnChanged>(this);
+	Scene.on_destroy<Tags::Static>().disconnect<&StaticLayer::OnRemoved>(this);
+}
+
+
+void StaticLayer::Invalidate(const SDL_FRect& Bounds)
+{
+	if (m_Chunks.empty())
+		return;
+
+	// one pixel of slack for the outline and rounding
+	const int x0 = std::clamp(int(std::floor(Bounds.x - 1.0f)) / ChunkSize, 0, m_ChunksX - 1);
+	const int y0 = std::clamp(int(std::floor(Bounds.y - 1.0f)) / ChunkSize, 0, m_ChunksY - 1);
+	const int x1 = std::clamp(int(std::ceil(Bounds.x + Bounds.w + 1.0f)) / ChunkSize, 0, m_ChunksX - 1);
+	const int y1 = std::clamp(int(std::ceil(Bounds.y + Bounds.h + 1.0f)) / ChunkSize, 0, m_ChunksY - 1);
+
+	for (int y = y0; y <= y1; ++y)
+		for (int x = x0; x <= x1; ++x)
+			m_Chunks[size_t(y) * m_ChunksX + x].Dirty = true;
+
+	m_Dirty = true;
+}
+
+
+void StaticLayer::InvalidateAll()
+{
+	for (auto& Chunk : m_Chunks)
+		Chunk.Dirty = true;
+
+	m_Dirty = true;
+}
+
+
+const std::vector<SDL_Rect>& StaticLayer::Update(Registry& Scene, SDLRenderBackend& Backend)
+{
+	m_Redrawn.clear();
+
+	if (!m_Dirty)
+		return m_Redrawn;
+
+	for (size_t i = 0; i < m_Chunks.size(); ++i)
+	{
+		if (m_Chunks[i].Dirty)
+			m_ChunkCommands[i].Clear();
+	}
+
+
+	// sort every static quad into the dirty chunks it overlaps, in chunk space
+	auto StaticView = Scene.view<TransformComponent, QuadComponent, ColorComponent, Tags::Static>();
+	for (auto [Entity, Transform, QuadData, ColorData] : StaticView.each())
+	{
+		const auto	Quad	= QuadData.World(Transform);
+		const auto& Color	= ColorData.m_Color;
+
+		const int x0 = std::clamp(int(std::floor(Quad.x)) / ChunkSize, 0, m_ChunksX - 1);
+		const int y0 = std::clamp(int(std::floor(Quad.y)) / ChunkSize, 0, m_ChunksY - 1);
+		const int x1 = std::clamp(int(std::ceil(Quad.x + Quad.w)) / ChunkSize, 0, m_ChunksX - 1);
+		const int y1 = std::clamp(int(std::ceil(Quad.y + Quad.h)) / ChunkSize, 0, m_ChunksY - 1);
+
+		for (int y = y0; y <= y1; ++y)
+		{
+			for (int x = x0; x <= x1; ++x)
+			{
+				const size_t Index = size_t(y) * m_ChunksX + x;
+
+				if (!m_Chunks[Index].Dirty)
+					continue;
+
+				const SDL_FRect Local{ Quad.x - float(x * ChunkSize), Quad.y - float(y * ChunkSize), Quad.w, Quad.h };
+
+				auto& Commands = m_ChunkCommands[Index];
+				Commands.Color(Color.r, Color.g, Color.b, Color.a);
+				Commands.Quad(Local, QuadFill | QuadOutline, entt::to_integral(Entity));
+			}
+		}
+	}
+
+
+	for (size_t i = 0; i < m_Chunks.size(); ++i)
+	{
+		auto& Chunk = m_Chunks[i];
+
+		if (!Chunk.Dirty)
+			continue;
+
+		Chunk.Dirty = false;
+		Chunk.Empty = m_ChunkCommands[i].size() == 0;
+
+		m_Redrawn.push_back(ChunkRect(i));
+
+		if (Chunk.Empty)
+			continue;
+
+		if (!Chunk.Texture)
+		{
+			Chunk.Texture = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, ChunkSize, ChunkSize);
+
+			if (!Chunk.Texture)
+			{
+				DebugLog();
+				Chunk.Empty = true;
+				continue;
+			}
+
+			SDL_SetTextureBlendMode(Chunk.Texture, SDL_BLENDMODE_BLEND);
+		}
+
+		SDL_SetRenderTarget(m_Renderer, Chunk.Texture);
+		SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 0);
+		SDL_RenderClear(m_Renderer);
+
+		Backend.Execute(m_ChunkCommands[i]);
+	}
+
+	SDL_SetRenderTarget(m_Renderer, nullptr);
+
+	m_Dirty = false;
+
+	return m_Redrawn;
+}
+
+
+void StaticLayer::Composite(RenderCommandList& Commands) const
+{
+	for (size_t i = 0; i < m_Chunks.size(); ++i)
+	{
+		if (m_Chunks[i].Empty)
+			continue;
+
+		const SDL_Rect Rect = ChunkRect(i);
+
+		Commands.Sprite(m_Chunks[i].Texture, SDL_Rect{}, SDL_FRect{ float(Rect.x), float(Rect.y), float(Rect.w), float(Rect.h) });
+	}
+}
+
+
+void StaticLayer::OnChanged(Registry& Scene, entt::entity Entity)
+{
+	if (!Scene.all_of<TransformComponent, QuadComponent, Tags::Static>(Entity))
+		return;
+
+	const auto Quad = Scene.get<QuadComponent>(Entity).World(Scene.get<TransformComponent>(Entity));
+
+	auto [It, Inserted] = m_Bounds.try_emplace(Entity, Quad);
+
+	if (!Inserted)
+	{
+		Invalidate(It->second);
+		It->second = Quad;
+	}
+
+	Invalidate(Quad);
+}
+
+
+void StaticLayer::OnRemoved(Registry& Scene, entt::entity Entity)
+{
+	if (auto It = m_Bounds.find(Entity); It != m_Bounds.end())
+	{
+		Invalidate(It->second);
+		m_Bounds.erase(It);
+	}
+}
+
+
+SDL_Rect StaticLayer::ChunkRect(size_t Index) const
+{
+	const int x = static_cast<int>(Index % m_ChunksX);
+	const int y = static_cast<int>(Index / m_ChunksX);
+
+	return SDL_Rect{ x * ChunkSize, y * ChunkSize, ChunkSize, ChunkSize };
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <entt/entt.hpp>
+
+#include "RenderCommand.hpp"
+
+#include "../Registry.hpp"
+
+#include <vector>
+
+class SDLRenderBackend;
+
+// caches geometry tagged Tags::Static in chunk sized render targets.
+// chunks are only redrawn when a static quad inside of them is added,
+// changed or removed, every frame just composites the cached textures.
+
+class StaticLayer
+{
+
+public:
+
+	static constexpr int ChunkSize = 256;
+
+
+public:
+
+	StaticLayer();
+	~StaticLayer() = default;
+
+
+public:
+
+	void Init(SDL_Renderer* Renderer, int Width, int Height);
+	void Shutdown();
+
+	void Connect(Registry& Scene);
+	void Disconnect(Registry& Scene);
+
+	void Invalidate(const SDL_FRect& Bounds);
+	void InvalidateAll();
+
+	// redraws dirty chunks, returns the screen rects that were redrawn
+	const std::vector<SDL_Rect>& Update(Registry& Scene, SDLRenderBackend& Backend);
+
+	void Composite(RenderCommandList& Commands) const;
+
+	bool Enabled() const { return m_Renderer != nullptr; }
+
+
+private:
+
+	struct Chunk
+	{
+		SDL_Texture*	Texture;
+		bool			Dirty;
+		bool			Empty;
+	};
+
+
+private:
+
+	void OnChanged(Registry& Scene, entt::entity Entity);
+	void OnRemoved(Registry& Scene, entt::entity Entity);
+
+	SDL_Rect ChunkRect(size_t Index) const;
+
+
+private:
+
+	SDL_Renderer*			m_Renderer;
+
+	int						m_ChunksX;
+	int						m_ChunksY;
+	std::vector<Chunk>		m_Chunks;
+	bool					m_Dirty;
+
+	std::vector<RenderCommandList>	m_ChunkCommands;
+	std::vector<SDL_Rect>			m_Redrawn;
+
+	// last known bounds of every static quad, so moving one also clears where it was
+	entt::dense_map<entt::entity, SDL_FRect>	m_Bounds;
+
+};
@@ -0,0 +1,125 @@
+#include "MappedFile.hpp"
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+	: m_Data(nullptr)
+	, m_Size(0)
+#if defined(_WIN32)
+	, m_File(INVALID_HANDLE_VALUE)
+	, m_Mapping(nullptr)
+#endif
+{
+
+}
+
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+
+bool MappedFile::Open(const char* Path)
+{
+	Close();
+
+#if defined(_WIN32)
+	m_File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (m_File == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER FileSize;
+
+	if (!GetFileSizeEx(m_File, &FileSize) || FileSize.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+
+	m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!m_Mapping)
+	{
+		Close();
+		return false;
+	}
+
+	m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+	m_Size = size_t(FileSize.QuadPart);
+
+#else
+	int File = open(Path, O_RDONLY);
+
+	if (File < 0)
+		return false;
+
+	struct stat Info;
+
+	if (fstat(File, &Info) != 0 || Info.st_size == 0)
+	{
+		close(File);
+		return false;
+	}
+
+	void* Mapped = mmap(nullptr, size_t(Info.st_size), PROT_READ, MAP_PRIVATE, File, 0);
+
+	// the mapping keeps the file alive on its own
+	close(File);
+
+	if (Mapped == MAP_FAILED)
+		return false;
+
+	// read front to back once, let the kernel read ahead aggressively
+	madvise(Mapped, size_t(Info.st_size), MADV_SEQUENTIAL);
+	madvise(Mapped, size_t(Info.st_size), MADV_WILLNEED);
+
+	m_Data = static_cast<const uint8_t*>(Mapped);
+	m_Size = size_t(Info.st_size);
+
+#endif
+
+	if (!m_Data)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+	if (m_Data)
+		UnmapViewOfFile(m_Data);
+
+	if (m_Mapping)
+		CloseHandle(m_Mapping);
+
+	if (m_File != INVALID_HANDLE_VALUE)
+		CloseHandle(m_File);
+
+	m_Mapping	= nullptr;
+	m_File		= INVALID_HANDLE_VALUE;
+
+#else
+	if (m_Data)
+		munmap(const_cast<uint8_t*>(m_Data), m_Size);
+
+#endif
+
+	m_Data = nullptr;
+	m_Size = 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// read only view of a whole file mapped into memory. Pages are faulted in
+// by the os as they are touched, nothing is copied into user buffers.
+
+class MappedFile
+{
+
+public:
+
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator = (const MappedFile&) = delete;
+
+
+public:
+
+	bool Open(const char* Path);
+	void Close();
+
+
+public:
+
+	const uint8_t*	Data() const { return m_Data; }
+	size_t			Size() const { return m_Size; }
+
+
+private:
+
+	const uint8_t*	m_Data;
+	size_t			m_Size;
+
+#if defined(_WIN32)
+	void*			m_File;
+	void*			m_Mapping;
+#endif
+
+};
@@ -0,0 +1,264 @@
+#include "RollbackBuffer.hpp"
+
+#include "../Components/AccelerationComponent.hpp"
+#include "../Components/ColorComponent.hpp"
+#include "../Components/HierarchyComponent.hpp"
+#include "../Components/QuadColliderComponent.hpp"
+#include "../Components/QuadComponent.hpp"
+#include "../Components/SpeedComponent.hpp"
+#include "../Components/Tags.hpp"
+#include "../Components/TransformComponent.hpp"
+#include "../Components/VelocityComponent.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+RollbackBuffer::RollbackBuffer()
+	: m_Head(0)
+	, m_Count(0)
+{
+
+}
+
+
+void RollbackBuffer::Init(size_t Ticks, const LevelMetadata& Level)
+{
+	// every entity in every storage, an upper bound that leaves the
+	// slabs alone for as long as the level stays within its metadata
+	const size_t Entities	= Level.Entities();
+	const size_t Payload	= sizeof(TransformComponent) + sizeof(QuadComponent) + sizeof(QuadColliderComponent) + sizeof(SpeedComponent) + sizeof(HierarchyComponent) + sizeof(ColorComponent)
+		+ sizeof(VelocityComponent) + sizeof(AccelerationComponent);
+	const size_t Bytes		= Entities * (StorageCount * sizeof(entt::entity) + Payload) + StorageCount * 2 * SlabAlignment;
+
+	m_Frames.assign(Ticks, Frame{});
+
+	for (Frame& Slot : m_Frames)
+		Slot.Slab.resize(Bytes);
+
+	m_Versions.reserve(Entities);
+	m_Doomed.reserve(Entities);
+
+	m_Head	= 0;
+	m_Count	= 0;
+}
+
+
+void RollbackBuffer::Save(const Registry& Scene, uint64_t Tick)
+{
+	if (m_Frames.empty())
+		return;
+
+	Frame& Target = m_Frames[m_Head];
+
+	Target.Tick = Tick;
+	Target.Used = 0;
+
+	SaveEntities(Scene, Target, Target.Slices[0]);
+	SaveStorage<Tags::Player>(Scene, Target, Target.Slices[1]);
+	SaveStorage<Tags::Enemy>(Scene, Target, Target.Slices[2]);
+	SaveStorage<TransformComponent>(Scene, Target, Target.Slices[3]);
+	SaveStorage<QuadComponent>(Scene, Target, Target.Slices[4]);
+	SaveStorage<QuadColliderComponent>(Scene, Target, Target.Slices[5]);
+	SaveStorage<SpeedComponent>(Scene, Target, Target.Slices[6]);
+	SaveStorage<HierarchyComponent>(Scene, Target, Target.Slices[7]);
+	SaveStorage<ColorComponent>(Scene, Target, Target.Slices[8]);
+	SaveStorage<VelocityComponent>(Scene, Target, Target.Slices[9]);
+	SaveStorage<AccelerationComponent>(Scene, Target, Target.Slices[10]);
+
+	m_Head	= (m_Head + 1) % m_Frames.size();
+	m_Count	= std::min(m_Count + 1, m_Frames.size());
+}
+
+
+void RollbackBuffer::Clear()
+{
+	m_Head	= 0;
+	m_Count	= 0;
+}
+
+
+bool RollbackBuffer::Restore(Registry& Scene, uint64_t Tick)
+{
+	if (Empty() || Tick < Oldest() || Tick > Newest())
+		return false;
+
+	// ticks are saved back to back, the age in ticks is the distance in slots
+	const size_t Age	= size_t(Newest() - Tick);
+	const size_t Slot	= (m_Head + m_Frames.size() - 1 - Age) % m_Frames.size();
+
+	const Frame& Source = m_Frames[Slot];
+
+	RestoreEntities(Scene, Source, Source.Slices[0]);
+	RestoreStorage<Tags::Player>(Scene, Source, Source.Slices[1]);
+	RestoreStorage<Tags::Enemy>(Scene, Source, Source.Slices[2]);
+	RestoreStorage<TransformComponent>(Scene, Source, Source.Slices[3]);
+	RestoreStorage<QuadComponent>(Scene, Source, Source.Slices[4]);
+	RestoreStorage<QuadColliderComponent>(Scene, Source, Source.Slices[5]);
+	RestoreStorage<SpeedComponent>(Scene, Source, Source.Slices[6]);
+	RestoreStorage<HierarchyComponent>(Scene, Source, Source.Slices[7]);
+	RestoreStorage<ColorComponent>(Scene, Source, Source.Slices[8]);
+	RestoreStorage<VelocityComponent>(Scene, Source, Source.Slices[9]);
+	RestoreStorage<AccelerationComponent>(Scene, Source, Source.Slices[10]);
+
+	// the restored tick becomes the newest one, the next save overwrites what came after it
+	m_Head	= (Slot + 1) % m_Frames.size();
+	m_Count	-= Age;
+
+	return true;
+}
+
+
+uint64_t RollbackBuffer::Oldest() const
+{
+	return Newest() - (m_Count - 1);
+}
+
+
+uint64_t RollbackBuffer::Newest() const
+{
+	return m_Frames[(m_Head + m_Frames.size() - 1) % m_Frames.size()].Tick;
+}
+
+
+size_t RollbackBuffer::Reserve(Frame& Target, size_t Bytes)
+{
+	const size_t Offset = (Target.Used + SlabAlignment - 1) & ~(SlabAlignment - 1);
+
+	// only when the level outgrew its metadata
+	if (Offset + Bytes > Target.Slab.size())
+		Target.Slab.resize((Offset + Bytes) * 2);
+
+	Target.Used = Offset + Bytes;
+
+	return Offset;
+}
+
+
+template<typename Type>
+void RollbackBuffer::SaveStorage(const Registry& Scene, Frame& Target, Slice& Into)
+{
+	Into = Slice{};
+
+	const auto* Storage = Scene.storage<Type>();
+
+	if (!Storage || Storage->empty())
+		return;
+
+	Into.Count		= Storage->size();
+	Into.Entities	= Reserve(Target, Into.Count * sizeof(entt::entity));
+
+	std::memcpy(Target.Slab.data() + Into.Entities, Storage->data(), Into.Count * sizeof(entt::entity));
+
+	if constexpr (!std::is_empty_v<Type>)
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "Rollback state is copied as raw bytes");
+
+		constexpr size_t PageSize = entt::component_traits<Type>::page_size;
+
+		Into.Payload = Reserve(Target, Into.Count * sizeof(Type));
+
+		Type* Destination = reinterpret_cast<Type*>(Target.Slab.data() + Into.Payload);
+
+		for (size_t First = 0; First < Into.Count; First += PageSize)
+			std::memcpy(Destination + First, Storage->raw()[First / PageSize], std::min(PageSize, Into.Count - First) * sizeof(Type));
+	}
+}
+
+
+void RollbackBuffer::SaveEntities(const Registry& Scene, Frame& Target, Slice& Into)
+{
+	const auto* Storage = Scene.storage<entt::entity>();
+
+	// destroyed identifiers too, they hold the versions recycling hands out next
+	Into.Count		= Storage->size();
+	Into.InUse		= Storage->in_use();
+	Into.Entities	= Reserve(Target, Into.Count * sizeof(entt::entity));
+
+	std::memcpy(Target.Slab.data() + Into.Entities, Storage->data(), Into.Count * sizeof(entt::entity));
+}
+
+
+template<typename Type>
+void RollbackBuffer::RestoreStorage(Registry& Scene, const Frame& Source, const Slice& From)
+{
+	auto& Storage = Scene.storage<Type>();
+
+	const auto* Entities = reinterpret_cast<const entt::entity*>(Source.Slab.data() + From.Entities);
+
+	// same entities in the same order, only the values moved on
+	if (Storage.size() == From.Count && (From.Count == 0 || std::memcmp(Storage.data(), Entities, From.Count * sizeof(entt::entity)) == 0))
+	{
+		if constexpr (!std::is_empty_v<Type>)
+		{
+			constexpr size_t PageSize = entt::component_traits<Type>::page_size;
+
+			const Type* Values = reinterpret_cast<const Type*>(Source.Slab.data() + From.Payload);
+
+			for (size_t First = 0; First < From.Count; First += PageSize)
+				std::memcpy(Storage.raw()[First / PageSize], Values + First, std::min(PageSize, From.Count - First) * sizeof(Type));
+		}
+
+		return;
+	}
+
+	// same entities, only reordered since (spatial sort), values go back by entity
+	if (Storage.size() == From.Count && std::all_of(Entities, Entities + From.Count, [&](entt::entity Entity) { return Storage.contains(Entity); }))
+	{
+		if constexpr (!std::is_empty_v<Type>)
+		{
+			const Type* Values = reinterpret_cast<const Type*>(Source.Slab.data() + From.Payload);
+
+			for (size_t i = 0; i < From.Count; i++)
+				Storage.get(Entities[i]) = Values[i];
+		}
+
+		return;
+	}
+
+	Storage.clear();
+
+	if constexpr (std::is_empty_v<Type>)
+		Storage.insert(Entities, Entities + From.Count);
+	else
+		Storage.insert(Entities, Entities + From.Count, reinterpret_cast<const Type*>(Source.Slab.data() + From.Payload));
+}
+
+
+void RollbackBuffer::RestoreEntities(Registry& Scene, const Frame& Source, const Slice& From)
+{
+	auto& Storage = Scene.storage<entt::entity>();
+
+	const auto* Entities = reinterpret_cast<const entt::entity*>(Source.Slab.data() + From.Entities);
+
+	if (Storage.size() == From.Count && Storage.in_use() == From.InUse && std::memcmp(Storage.data(), Entities, From.Count * sizeof(entt::entity)) == 0)
+		return;
+
+	using Traits = entt::entt_traits<entt::entity>;
+
+	// version every entity index had at the saved tick, null if it wasn't alive
+	m_Versions.assign(From.Count, entt::null);
+
+	for (size_t i = 0; i < From.InUse; i++)
+		m_Versions[Traits::to_entity(Entities[i])] = Entities[i];
+
+	// whatever was spawned since, or recycled into a slot that was alive back then
+	m_Doomed.clear();
+
+	for (auto [Entity] : Storage.each())
+	{
+		const size_t Index = Traits::to_entity(Entity);
+
+		if (Index >= m_Versions.size() || m_Versions[Index] != Entity)
+			m_Doomed.push_back(Entity);
+	}
+
+	Scene.destroy(m_Doomed.begin(), m_Doomed.end());
+
+	// and back what was destroyed since, with the version it had
+	for (size_t i = 0; i < From.InUse; i++)
+	{
+		if (!Scene.valid(Entities[i]))
+			Storage.emplace(Entities[i]);
+	}
+}
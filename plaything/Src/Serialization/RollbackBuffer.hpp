@@ -0,0 +1,103 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../LevelMetadata.hpp"
+#include "../Registry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// the last few ticks of simulation state, for rewinding without replaying.
+// Every tick the entity list and the dynamic storages are copied page by
+// page into a slab allocated up front, so saving costs a memcpy of the
+// live data. Restoring copies the components straight back into their
+// pages when the storage still holds the same entities in the same order,
+// assigns them entity by entity when only the order changed, and only
+// falls back to clearing and range inserting a storage when entities were
+// spawned or destroyed in between.
+//
+// Tags::Static never changes after the level is built and isn't part of
+// the state.
+
+class RollbackBuffer
+{
+
+public:
+
+	RollbackBuffer();
+	~RollbackBuffer() = default;
+
+
+public:
+
+	// Ticks slabs, each big enough for everything the level reserves
+	void Init(size_t Ticks, const LevelMetadata& Level);
+
+	// drops the oldest tick once all slabs are taken
+	void Save(const Registry& Scene, uint64_t Tick);
+
+	// puts the scene back to how it was at the end of Tick and forgets
+	// every tick after it, false if Tick is no longer (or not yet) held
+	bool Restore(Registry& Scene, uint64_t Tick);
+
+	// forgets every tick held, for when the scene changed in a way a
+	// restore can't undo
+	void Clear();
+
+
+public:
+
+	bool		Empty()		const { return m_Count == 0; }
+	uint64_t	Oldest()	const;
+	uint64_t	Newest()	const;
+
+
+private:
+
+	static constexpr size_t StorageCount	= 11;
+	static constexpr size_t SlabAlignment	= 16;
+
+	// where one storage sits in a slab
+	struct Slice
+	{
+		size_t	Entities	= 0;
+		size_t	Count		= 0;
+		size_t	Payload		= 0;
+		size_t	InUse		= 0;
+	};
+
+	struct Frame
+	{
+		uint64_t				Tick = 0;
+		std::vector<uint8_t>	Slab;
+		size_t					Used = 0;
+		Slice					Slices[StorageCount];
+	};
+
+
+private:
+
+	size_t Reserve(Frame& Target, size_t Bytes);
+
+	template<typename Type>
+	void SaveStorage(const Registry& Scene, Frame& Target, Slice& Into);
+	void SaveEntities(const Registry& Scene, Frame& Target, Slice& Into);
+
+	template<typename Type>
+	void RestoreStorage(Registry& Scene, const Frame& Source, const Slice& From);
+	void RestoreEntities(Registry& Scene, const Frame& Source, const Slice& From);
+
+
+private:
+
+	std::vector<Frame>			m_Frames;
+	size_t						m_Head;		// slot the next save goes into
+	size_t						m_Count;
+
+	// scratch for restoring the entity list, saved version per entity index
+	std::vector<entt::entity>	m_Versions;
+	std::vector<entt::entity>	m_Doomed;
+
+};
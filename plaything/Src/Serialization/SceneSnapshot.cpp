@@ -0,0 +1,190 @@
+#include "SceneSnapshot.hpp"
+
+#include "MappedFile.hpp"
+#include "SnapshotArchive.hpp"
+
+#include "../Components/AccelerationComponent.hpp"
+#include "../Components/ColorComponent.hpp"
+#include "../Components/HierarchyComponent.hpp"
+#include "../Components/QuadColliderComponent.hpp"
+#include "../Components/QuadComponent.hpp"
+#include "../Components/SpeedComponent.hpp"
+#include "../Components/Tags.hpp"
+#include "../Components/TransformComponent.hpp"
+#include "../Components/VelocityComponent.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+	// every storage that ends up in a file, in file order.
+	// Appending or changing a component means bumping Version
+	using SceneComponents = entt::type_list<
+		Tags::Static,
+		Tags::Player,
+		Tags::Enemy,
+		TransformComponent,
+		QuadComponent,
+		QuadColliderComponent,
+		ColorComponent,
+		SpeedComponent,
+		HierarchyComponent,
+		VelocityComponent,
+		AccelerationComponent>;
+
+	constexpr uint32_t Magic	= 0x43534c50;	// "PLSC"
+	constexpr uint32_t Version	= 5 | SimulationFormat;
+
+
+	template<typename Component>
+	constexpr uint32_t StoredSize()
+	{
+		return std::is_empty_v<Component> ? 0 : sizeof(Component);
+	}
+
+
+	template<typename... Components>
+	void WriteHeader(Serialization::SnapshotWriter& Archive, entt::type_list<Components...>)
+	{
+		Archive(Magic);
+		Archive(Version);
+		Archive(uint32_t(sizeof...(Components)));
+
+		(Archive(StoredSize<Components>()), ...);
+	}
+
+
+	template<typename... Components>
+	bool ReadHeader(Serialization::SnapshotReader& Archive, entt::type_list<Components...>)
+	{
+		uint32_t FileMagic = 0, FileVersion = 0, FileComponents = 0;
+
+		Archive(FileMagic);
+		Archive(FileVersion);
+		Archive(FileComponents);
+
+		if (FileMagic != Magic || FileVersion != Version || FileComponents != sizeof...(Components))
+			return false;
+
+		// a component whose layout changed since the file was written
+		const uint32_t Sizes[] = { StoredSize<Components>()... };
+
+		for (uint32_t Size : Sizes)
+		{
+			uint32_t FileSize = 0;
+			Archive(FileSize);
+
+			if (FileSize != Size)
+				return false;
+		}
+
+		return !Archive.Failed();
+	}
+
+
+	template<typename... Components>
+	void SaveComponents(const Registry& Scene, Serialization::SnapshotWriter& Archive, entt::type_list<Components...>)
+	{
+		entt::basic_snapshot<Registry>{ Scene }
+			.entities(Archive)
+			.template component<Components...>(Archive);
+	}
+
+
+	// one block straight from the mapping into the storage, a single range insert
+	template<typename Component>
+	bool LoadComponent(Registry& Scene, Serialization::SnapshotReader& Archive)
+	{
+		uint32_t Count = 0;
+		Archive(Count);
+
+		if (Count == 0)
+			return !Archive.Failed();
+
+		const entt::entity* Entities = Archive.Read<entt::entity>(Count);
+
+		if (!Entities || !std::all_of(Entities, Entities + Count, [&](entt::entity Entity) { return Scene.valid(Entity); }))
+			return false;
+
+		if constexpr (std::is_empty_v<Component>)
+		{
+			Scene.insert<Component>(Entities, Entities + Count);
+		}
+		else
+		{
+			Archive.Align(alignof(Component));
+
+			const Component* Instances = Archive.Read<Component>(Count);
+
+			if (!Instances)
+				return false;
+
+			Scene.insert<Component>(Entities, Entities + Count, Instances);
+		}
+
+		return true;
+	}
+
+
+	template<typename... Components>
+	bool LoadComponents(Registry& Scene, Serialization::SnapshotReader& Archive, entt::type_list<Components...>)
+	{
+		// identifiers in the same order the snapshot wrote them, alive ones
+		// first and the destroyed ones after, so recycling picks up where it left off
+		uint32_t Count = 0, InUse = 0;
+
+		Archive(Count);
+		Archive(InUse);
+
+		const entt::entity* Entities = Archive.Read<entt::entity>(Count);
+
+		if (!Entities || InUse > Count)
+			return false;
+
+		auto& Storage = Scene.storage<entt::entity>();
+
+		Storage.reserve(Count);
+		Storage.push(Entities, Entities + Count);
+		Storage.in_use(InUse);
+
+		return (LoadComponent<Components>(Scene, Archive) && ...);
+	}
+}
+
+
+namespace Serialization
+{
+	bool SaveScene(const Registry& Scene, const char* Path)
+	{
+		SDL_RWops* File = SDL_RWFromFile(Path, "wb");
+
+		if (!File)
+			return false;
+
+		SnapshotWriter Archive(File);
+
+		WriteHeader(Archive, SceneComponents{});
+		SaveComponents(Scene, Archive, SceneComponents{});
+
+		const bool Written = Archive.Finish();
+
+		return SDL_RWclose(File) == 0 && Written;
+	}
+
+
+	bool LoadScene(Registry& Scene, const char* Path)
+	{
+		MappedFile File;
+
+		if (!File.Open(Path))
+			return false;
+
+		SnapshotReader Archive(File.Data(), File.Size());
+
+		if (!ReadHeader(Archive, SceneComponents{}))
+			return false;
+
+		return LoadComponents(Scene, Archive, SceneComponents{});
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "../Registry.hpp"
+
+// binary save and load of a whole scene. Identifiers are kept as they
+// were, loading expects a registry that never had an entity in it.
+
+namespace Serialization
+{
+	bool SaveScene(const Registry& Scene, const char* Path);
+	bool LoadScene(Registry& Scene, const char* Path);
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <SDL2/SDL_rwops.h>
+#include <entt/entt.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// archives for entt::basic_snapshot.
+// entt hands components over one (entity, instance) pair at a time, the
+// writer gathers them and lays every storage out as one block:
+//
+//	[count] [count entities] [padding to alignof(Component)] [count components]
+//
+// so the reader can hand both arrays straight out of a mapped file to a
+// range insert. Components are written as raw bytes, only trivially
+// copyable types can go through here.
+
+namespace Serialization
+{
+	class SnapshotWriter
+	{
+
+	public:
+
+		explicit SnapshotWriter(SDL_RWops* File)
+			: m_File(File), m_Offset(0), m_Pending(0), m_Failed(false) { }
+
+		~SnapshotWriter() = default;
+
+
+	public:
+
+		// element counts and header fields
+		void operator () (uint32_t Value)
+		{
+			Write(&Value, sizeof(Value));
+			m_Pending = Value;
+		}
+
+		// entity identifiers and empty (tag) components
+		void operator () (entt::entity Entity)
+		{
+			Write(&Entity, sizeof(Entity));
+		}
+
+		template<typename Component>
+		void operator () (entt::entity Entity, const Component& Instance)
+		{
+			static_assert(std::is_trivially_copyable_v<Component>, "Components are written as raw bytes");
+
+			const auto* Bytes = reinterpret_cast<const uint8_t*>(&Instance);
+
+			m_Entities.push_back(Entity);
+			m_Instances.insert(m_Instances.end(), Bytes, Bytes + sizeof(Component));
+
+			if (m_Entities.size() == m_Pending)
+			{
+				Write(m_Entities.data(), m_Entities.size() * sizeof(entt::entity));
+				Align(alignof(Component));
+				Write(m_Instances.data(), m_Instances.size());
+
+				m_Entities.clear();
+				m_Instances.clear();
+			}
+		}
+
+
+	public:
+
+		// pushes everything buffered to the file, false if any write failed
+		bool Finish()
+		{
+			Flush();
+			return !m_Failed;
+		}
+
+
+	private:
+
+		void Write(const void* Data, size_t Bytes)
+		{
+			const auto* Source = static_cast<const uint8_t*>(Data);
+
+			m_Buffer.insert(m_Buffer.end(), Source, Source + Bytes);
+			m_Offset += Bytes;
+
+			if (m_Buffer.size() >= FlushSize)
+				Flush();
+		}
+
+		void Align(size_t Alignment)
+		{
+			static const uint8_t Zero[16] = {};
+
+			Write(Zero, (Alignment - m_Offset % Alignment) % Alignment);
+		}
+
+		void Flush()
+		{
+			if (!m_Buffer.empty() && SDL_RWwrite(m_File, m_Buffer.data(), 1, m_Buffer.size()) != m_Buffer.size())
+				m_Failed = true;
+
+			m_Buffer.clear();
+		}
+
+
+	private:
+
+		static constexpr size_t FlushSize = size_t(1) << 20;
+
+		SDL_RWops*					m_File;
+		std::vector<uint8_t>		m_Buffer;
+		size_t						m_Offset;
+
+		std::vector<entt::entity>	m_Entities;
+		std::vector<uint8_t>		m_Instances;
+		size_t						m_Pending;
+
+		bool						m_Failed;
+
+	};
+
+
+	// reads the blocks back straight out of memory, normally a MappedFile.
+	// Running past the end yields zeros and marks the reader as failed
+	// instead of reading on.
+
+	class SnapshotReader
+	{
+
+	public:
+
+		SnapshotReader(const uint8_t* Data, size_t Size)
+			: m_Data(Data), m_Offset(0), m_Size(Size), m_Failed(false) { }
+
+		~SnapshotReader() = default;
+
+
+	public:
+
+		void operator () (uint32_t& Value)
+		{
+			const uint32_t* Source = Read<uint32_t>(1);
+			Value = Source ? *Source : 0;
+		}
+
+
+	public:
+
+		// Count elements in place, nullptr if the data ends before them
+		template<typename Type>
+		const Type* Read(size_t Count)
+		{
+			static_assert(std::is_trivially_copyable_v<Type>, "Only raw bytes can be read in place");
+
+			if (m_Failed || (m_Size - m_Offset) / sizeof(Type) < Count)
+			{
+				m_Failed = true;
+				return nullptr;
+			}
+
+			const Type* Data = reinterpret_cast<const Type*>(m_Data + m_Offset);
+			m_Offset += Count * sizeof(Type);
+
+			return Data;
+		}
+
+		void Align(size_t Alignment)
+		{
+			m_Offset = std::min(m_Size, m_Offset + (Alignment - m_Offset % Alignment) % Alignment);
+		}
+
+
+	public:
+
+		bool	Failed()	const { return m_Failed; }
+
+
+	private:
+
+		const uint8_t*	m_Data;
+		size_t			m_Offset;
+		size_t			m_Size;
+		bool			m_Failed;
+
+	};
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "Vector2.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+
+// float registers for the hot loops. Float8 is a single AVX register when
+// the build targets AVX2 (/arch:AVX2, -mavx2) and two SSE halves otherwise,
+// Float4 is SSE. Builds without SSE, or with PLAYTHING_SIMD_SCALAR defined,
+// get plain arrays the compiler is free to vectorize on its own. Vector2x4
+// and Vector2x8 pack Vector2s on top of them for structure-of-arrays math,
+// x and y of several entities in one register each.
+//
+// Everything here is inline, a wide op that's a function call is no faster
+// than the scalar loop it replaces.
+
+#if !defined(PLAYTHING_SIMD_SCALAR)
+	#if defined(__AVX2__)
+		#define PLAYTHING_SIMD_AVX2
+	#endif
+
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define PLAYTHING_SIMD_SSE
+	#endif
+
+	// MSVC has no __FMA__, every AVX2 cpu has FMA3 though
+	#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+		#define PLAYTHING_SIMD_FMA
+	#endif
+#endif
+
+#if defined(PLAYTHING_SIMD_SSE) || defined(PLAYTHING_SIMD_AVX2)
+	#include <immintrin.h>
+#endif
+
+namespace Simd
+{
+
+	// 4 floats
+
+	struct Float4
+	{
+		static constexpr size_t Width = 4;
+
+#if defined(PLAYTHING_SIMD_SSE)
+
+		__m128 v;
+
+		static Float4	Load(const float* From)		{ return { _mm_loadu_ps(From) }; }
+		static Float4	Broadcast(float Value)		{ return { _mm_set1_ps(Value) }; }
+		void			Store(float* To)	const	{ _mm_storeu_ps(To, v); }
+
+#else
+
+		float v[4];
+
+		static Float4	Load(const float* From)		{ return { { From[0], From[1], From[2], From[3] } }; }
+		static Float4	Broadcast(float Value)		{ return { { Value, Value, Value, Value } }; }
+		void			Store(float* To)	const	{ for (size_t i = 0; i < 4; i++) To[i] = v[i]; }
+
+#endif
+	};
+
+#if defined(PLAYTHING_SIMD_SSE)
+
+	inline Float4 operator + (Float4 Lhs, Float4 Rhs)	{ return { _mm_add_ps(Lhs.v, Rhs.v) }; }
+	inline Float4 operator - (Float4 Lhs, Float4 Rhs)	{ return { _mm_sub_ps(Lhs.v, Rhs.v) }; }
+	inline Float4 operator * (Float4 Lhs, Float4 Rhs)	{ return { _mm_mul_ps(Lhs.v, Rhs.v) }; }
+	inline Float4 operator / (Float4 Lhs, Float4 Rhs)	{ return { _mm_div_ps(Lhs.v, Rhs.v) }; }
+
+	inline Float4 Min(Float4 Lhs, Float4 Rhs)	{ return { _mm_min_ps(Lhs.v, Rhs.v) }; }
+	inline Float4 Max(Float4 Lhs, Float4 Rhs)	{ return { _mm_max_ps(Lhs.v, Rhs.v) }; }
+	inline Float4 Sqrt(Float4 Value)			{ return { _mm_sqrt_ps(Value.v) }; }
+
+	// swaps every pair of lanes, x and y of Vector2s stored interleaved
+	inline Float4 SwapPairs(Float4 Value)		{ return { _mm_shuffle_ps(Value.v, Value.v, _MM_SHUFFLE(2, 3, 0, 1)) }; }
+
+	// A * B + C, one rounding where the cpu has FMA
+	inline Float4 MultiplyAdd(Float4 A, Float4 B, Float4 C)
+	{
+#if defined(PLAYTHING_SIMD_FMA)
+		return { _mm_fmadd_ps(A.v, B.v, C.v) };
+#else
+		return { _mm_add_ps(_mm_mul_ps(A.v, B.v), C.v) };
+#endif
+	}
+
+#else
+
+	template<typename Op>
+	inline Float4 Apply(Float4 Lhs, Float4 Rhs, Op Operation)
+	{
+		Float4 Result;
+
+		for (size_t i = 0; i < 4; i++)
+			Result.v[i] = Operation(Lhs.v[i], Rhs.v[i]);
+
+		return Result;
+	}
+
+	inline Float4 operator + (Float4 Lhs, Float4 Rhs)	{ return Apply(Lhs, Rhs, [](float a, float b) { return a + b; }); }
+	inline Float4 operator - (Float4 Lhs, Float4 Rhs)	{ return Apply(Lhs, Rhs, [](float a, float b) { return a - b; }); }
+	inline Float4 operator * (Float4 Lhs, Float4 Rhs)	{ return Apply(Lhs, Rhs, [](float a, float b) { return a * b; }); }
+	inline Float4 operator / (Float4 Lhs, Float4 Rhs)	{ return Apply(Lhs, Rhs, [](float a, float b) { return a / b; }); }
+
+	inline Float4 Min(Float4 Lhs, Float4 Rhs)	{ return Apply(Lhs, Rhs, [](float a, float b) { return b < a ? b : a; }); }
+	inline Float4 Max(Float4 Lhs, Float4 Rhs)	{ return Apply(Lhs, Rhs, [](float a, float b) { return a < b ? b : a; }); }
+	inline Float4 Sqrt(Float4 Value)			{ return Apply(Value, Value, [](float a, float) { return std::sqrt(a); }); }
+	inline Float4 SwapPairs(Float4 Value)		{ return { { Value.v[1], Value.v[0], Value.v[3], Value.v[2] } }; }
+
+	inline Float4 MultiplyAdd(Float4 A, Float4 B, Float4 C) { return A * B + C; }
+
+#endif
+
+
+	// 8 floats
+
+	struct Float8
+	{
+		static constexpr size_t Width = 8;
+
+#if defined(PLAYTHING_SIMD_AVX2)
+
+		__m256 v;
+
+		static Float8	Load(const float* From)		{ return { _mm256_loadu_ps(From) }; }
+		static Float8	Broadcast(float Value)		{ return { _mm256_set1_ps(Value) }; }
+		void			Store(float* To)	const	{ _mm256_storeu_ps(To, v); }
+
+#else
+
+		Float4 Low;
+		Float4 High;
+
+		static Float8	Load(const float* From)		{ return { Float4::Load(From), Float4::Load(From + 4) }; }
+		static Float8	Broadcast(float Value)		{ return { Float4::Broadcast(Value), Float4::Broadcast(Value) }; }
+		void			Store(float* To)	const	{ Low.Store(To); High.Store(To + 4); }
+
+#endif
+	};
+
+#if defined(PLAYTHING_SIMD_AVX2)
+
+	inline Float8 operator + (Float8 Lhs, Float8 Rhs)	{ return { _mm256_add_ps(Lhs.v, Rhs.v) }; }
+	inline Float8 operator - (Float8 Lhs, Float8 Rhs)	{ return { _mm256_sub_ps(Lhs.v, Rhs.v) }; }
+	inline Float8 operator * (Float8 Lhs, Float8 Rhs)	{ return { _mm256_mul_ps(Lhs.v, Rhs.v) }; }
+	inline Float8 operator / (Float8 Lhs, Float8 Rhs)	{ return { _mm256_div_ps(Lhs.v, Rhs.v) }; }
+
+	inline Float8 Min(Float8 Lhs, Float8 Rhs)	{ return { _mm256_min_ps(Lhs.v, Rhs.v) }; }
+	inline Float8 Max(Float8 Lhs, Float8 Rhs)	{ return { _mm256_max_ps(Lhs.v, Rhs.v) }; }
+	inline Float8 Sqrt(Float8 Value)			{ return { _mm256_sqrt_ps(Value.v) }; }
+	inline Float8 SwapPairs(Float8 Value)		{ return { _mm256_permute_ps(Value.v, _MM_SHUFFLE(2, 3, 0, 1)) }; }
+
+	inline Float8 MultiplyAdd(Float8 A, Float8 B, Float8 C)
+	{
+#if defined(PLAYTHING_SIMD_FMA)
+		return { _mm256_fmadd_ps(A.v, B.v, C.v) };
+#else
+		return { _mm256_add_ps(_mm256_mul_ps(A.v, B.v), C.v) };
+#endif
+	}
+
+#else
+
+	inline Float8 operator + (Float8 Lhs, Float8 Rhs)	{ return { Lhs.Low + Rhs.Low, Lhs.High + Rhs.High }; }
+	inline Float8 operator - (Float8 Lhs, Float8 Rhs)	{ return { Lhs.Low - Rhs.Low, Lhs.High - Rhs.High }; }
+	inline Float8 operator * (Float8 Lhs, Float8 Rhs)	{ return { Lhs.Low * Rhs.Low, Lhs.High * Rhs.High }; }
+	inline Float8 operator / (Float8 Lhs, Float8 Rhs)	{ return { Lhs.Low / Rhs.Low, Lhs.High / Rhs.High }; }
+
+	inline Float8 Min(Float8 Lhs, Float8 Rhs)	{ return { Min(Lhs.Low, Rhs.Low), Min(Lhs.High, Rhs.High) }; }
+	inline Float8 Max(Float8 Lhs, Float8 Rhs)	{ return { Max(Lhs.Low, Rhs.Low), Max(Lhs.High, Rhs.High) }; }
+	inline Float8 Sqrt(Float8 Value)			{ return { Sqrt(Value.Low), Sqrt(Value.High) }; }
+	inline Float8 SwapPairs(Float8 Value)		{ return { SwapPairs(Value.Low), SwapPairs(Value.High) }; }
+
+	inline Float8 MultiplyAdd(Float8 A, Float8 B, Float8 C) { return { MultiplyAdd(A.Low, B.Low, C.Low), MultiplyAdd(A.High, B.High, C.High) }; }
+
+#endif
+
+
+	// Width Vector2s, loaded from and stored to separate x and y arrays
+
+	template<typename Float>
+	struct Vector2Batch
+	{
+		static constexpr size_t Width = Float::Width;
+
+		Float x;
+		Float y;
+
+		static Vector2Batch Load(const float* X, const float* Y)	{ return { Float::Load(X), Float::Load(Y) }; }
+		static Vector2Batch Broadcast(Vector2 Value)				{ return { Float::Broadcast(Value.x), Float::Broadcast(Value.y) }; }
+
+		void Store(float* X, float* Y) const
+		{
+			x.Store(X);
+			y.Store(Y);
+		}
+
+		Float Dot(const Vector2Batch& Rhs)	const	{ return MultiplyAdd(x, Rhs.x, y * Rhs.y); }
+		Float Magnitude()					const	{ return Sqrt(Dot(*this)); }
+
+		// no branch per lane, zero vectors stay zero instead of turning into NaNs
+		Vector2Batch Normalize() const
+		{
+			const Float Length = Max(Magnitude(), Float::Broadcast(FLT_MIN));
+
+			return { x / Length, y / Length };
+		}
+	};
+
+	template<typename Float>
+	inline Vector2Batch<Float> operator + (const Vector2Batch<Float>& Lhs, const Vector2Batch<Float>& Rhs) { return { Lhs.x + Rhs.x, Lhs.y + Rhs.y }; }
+
+	template<typename Float>
+	inline Vector2Batch<Float> operator - (const Vector2Batch<Float>& Lhs, const Vector2Batch<Float>& Rhs) { return { Lhs.x - Rhs.x, Lhs.y - Rhs.y }; }
+
+	// per lane scale
+	template<typename Float>
+	inline Vector2Batch<Float> operator * (const Vector2Batch<Float>& Lhs, Float Scale) { return { Lhs.x * Scale, Lhs.y * Scale }; }
+
+	template<typename Float>
+	inline Vector2Batch<Float> operator * (const Vector2Batch<Float>& Lhs, float Scale) { return Lhs * Float::Broadcast(Scale); }
+
+	// A * Scale + B
+	template<typename Float>
+	inline Vector2Batch<Float> MultiplyAdd(const Vector2Batch<Float>& A, Float Scale, const Vector2Batch<Float>& B)
+	{
+		return { MultiplyAdd(A.x, Scale, B.x), MultiplyAdd(A.y, Scale, B.y) };
+	}
+
+	using Vector2x4 = Vector2Batch<Float4>;
+	using Vector2x8 = Vector2Batch<Float8>;
+
+
+	// X, Y += Dx, Dy * Scale over whole arrays, 8 at a time with the rest one
+	// by one. The usual position += velocity * dt
+	inline void MultiplyAdd(float* X, float* Y, const float* Dx, const float* Dy, float Scale, size_t Count)
+	{
+		const Float8 Scale8 = Float8::Broadcast(Scale);
+
+		const size_t Batched = Count - Count % Vector2x8::Width;
+
+		for (size_t i = 0; i < Batched; i += Vector2x8::Width)
+			MultiplyAdd(Vector2x8::Load(Dx + i, Dy + i), Scale8, Vector2x8::Load(X + i, Y + i)).Store(X + i, Y + i);
+
+		for (size_t i = Batched; i < Count; i++)
+		{
+			X[i] += Dx[i] * Scale;
+			Y[i] += Dy[i] * Scale;
+		}
+	}
+
+}
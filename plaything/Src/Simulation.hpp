@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Fixed.hpp"
+#include "Vector2.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+// what the simulation (positions, speeds, colliders) counts in. Float by
+// default. Building with PLAYTHING_FIXED_POINT switches it to Q16.16 so
+// movement and collision come out bit identical on every build, which
+// replays and lockstep need. Rendering stays float either way.
+
+#if defined(PLAYTHING_FIXED_POINT)
+	using SimScalar = Fixed;
+#else
+	using SimScalar = float;
+#endif
+
+using SimVector2 = BasicVector2<SimScalar>;
+
+// or'd into the version of every file that stores simulation state as raw
+// bytes, a fixed point build can't read a float build's files or back
+constexpr uint32_t SimulationFormat = std::is_same_v<SimScalar, Fixed> ? 1u << 16 : 0u;
@@ -0,0 +1,20 @@
+#include "ColliderBoundsSystem.hpp"
+
+#include "../Components/QuadColliderComponent.hpp"
+#include "../Components/TransformComponent.hpp"
+
+namespace Systems
+{
+	void UpdateColliderBounds(Registry& Scene)
+	{
+		auto ColliderView = Scene.view<TransformComponent, QuadColliderComponent>();
+		for (auto [Entity, Transform, Collider] : ColliderView.each())
+		{
+			if (!Transform.m_Dirty)
+				continue;
+
+			Collider.UpdateBounds(Transform);
+			Transform.m_Dirty = false;
+		}
+	}
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../Registry.hpp"
+
+namespace Systems
+{
+	// derives world space collider bounds for every transform that moved
+	// since the last pass and clears its dirty flag
+	void UpdateColliderBounds(Registry& Scene);
+}
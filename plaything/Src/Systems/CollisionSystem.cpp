@@ -0,0 +1,102 @@
+#include "CollisionSystem.hpp"
+
+#include "Groups.hpp"
+
+#include "../Simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+
+// Overlaps4 picks its kernel off Simd.hpp's detection. Every x64 cpu has
+// SSE2, only PLAYTHING_SIMD_SCALAR should ever take the scalar loop there
+#if (defined(_M_X64) || defined(__x86_64__)) && !defined(PLAYTHING_SIMD_SSE) && !defined(PLAYTHING_SIMD_SCALAR)
+	#error "x64 build without the SSE collision kernel, Simd.hpp isn't included"
+#endif
+
+namespace
+{
+	constexpr size_t PageSize = entt::component_traits<QuadColliderComponent>::page_size;
+
+	static_assert(PageSize % 4 == 0, "Blocks of four colliders can't straddle a page");
+	static_assert(sizeof(ColliderBox) == 4 * sizeof(float), "Bounds load as one register");
+
+	// bit i set when the i-th of the four colliders from First overlaps Subject
+	uint32_t Overlaps4(const ColliderBox& Subject, const QuadColliderComponent* First)
+	{
+#if defined(PLAYTHING_SIMD_SSE)
+
+		// the bits are moved around as floats, only the compares care what they are
+		const auto Less = [](__m128 Lhs, __m128 Rhs)
+		{
+			if constexpr (std::is_same_v<SimScalar, Fixed>)
+				return _mm_castsi128_ps(_mm_cmplt_epi32(_mm_castps_si128(Lhs), _mm_castps_si128(Rhs)));
+			else
+				return _mm_cmplt_ps(Lhs, Rhs);
+		};
+
+		const __m128 Box = _mm_loadu_ps(reinterpret_cast<const float*>(&Subject));
+
+		const __m128 SubjectMinX = _mm_shuffle_ps(Box, Box, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 SubjectMinY = _mm_shuffle_ps(Box, Box, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 SubjectMaxX = _mm_shuffle_ps(Box, Box, _MM_SHUFFLE(2, 2, 2, 2));
+		const __m128 SubjectMaxY = _mm_shuffle_ps(Box, Box, _MM_SHUFFLE(3, 3, 3, 3));
+
+		// four boxes in, min x / min y / max x / max y of all four out
+		__m128 MinX = _mm_loadu_ps(reinterpret_cast<const float*>(&First[0].m_Bounds));
+		__m128 MinY = _mm_loadu_ps(reinterpret_cast<const float*>(&First[1].m_Bounds));
+		__m128 MaxX = _mm_loadu_ps(reinterpret_cast<const float*>(&First[2].m_Bounds));
+		__m128 MaxY = _mm_loadu_ps(reinterpret_cast<const float*>(&First[3].m_Bounds));
+
+		_MM_TRANSPOSE4_PS(MinX, MinY, MaxX, MaxY);
+
+		const __m128 Horizontal	= _mm_and_ps(Less(SubjectMinX, MaxX), Less(MinX, SubjectMaxX));
+		const __m128 Vertical	= _mm_and_ps(Less(SubjectMinY, MaxY), Less(MinY, SubjectMaxY));
+
+		return uint32_t(_mm_movemask_ps(_mm_and_ps(Horizontal, Vertical)));
+
+#else
+
+		uint32_t Mask = 0;
+
+		for (uint32_t i = 0; i < 4; i++)
+			Mask |= uint32_t(Subject.Overlaps(First[i].m_Bounds)) << i;
+
+		return Mask;
+
+#endif
+	}
+}
+
+namespace Systems
+{
+	void CollectEnemyHits(Registry& Scene, const ColliderBox& Subject, std::vector<entt::entity>& Hits)
+	{
+		// the group owns the colliders, its entities are the front of the storage
+		const size_t Count = Groups::Enemies(Scene).size();
+
+		auto& Colliders = Scene.storage<QuadColliderComponent>();
+
+		QuadColliderComponent* const*	Pages		= Colliders.raw();
+		const entt::entity*				Entities	= Colliders.data();
+
+		const size_t First = Hits.size();
+
+		size_t i = 0;
+
+		for (; i + 4 <= Count; i += 4)
+		{
+			for (uint32_t Mask = Overlaps4(Subject, &Pages[i / PageSize][i % PageSize]); Mask; Mask &= Mask - 1)
+				Hits.push_back(Entities[i + std::countr_zero(Mask)]);
+		}
+
+		for (; i < Count; i++)
+		{
+			if (Subject.Overlaps(Pages[i / PageSize][i % PageSize].m_Bounds))
+				Hits.push_back(Entities[i]);
+		}
+
+		// groups iterate back to front
+		std::reverse(Hits.begin() + First, Hits.end());
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../Components/QuadColliderComponent.hpp"
+#include "../Registry.hpp"
+
+#include <vector>
+
+namespace Systems
+{
+	// appends every enemy whose collider bounds overlap Subject to Hits, in
+	// the order iterating Groups::Enemies visits them. Tests four colliders
+	// per step straight out of the owned collider storage, on float or
+	// fixed point bounds alike
+	void CollectEnemyHits(Registry& Scene, const ColliderBox& Subject, std::vector<entt::entity>& Hits);
+}
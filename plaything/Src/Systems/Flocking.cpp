@@ -0,0 +1,274 @@
+#include "Flocking.hpp"
+
+#include "Groups.hpp"
+
+#include "../Components/PathComponent.hpp"
+#include "../Simd.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <type_traits>
+
+namespace
+{
+	// agents a job steers, big enough that handing out chunks costs nothing
+	constexpr size_t ChunkSize = 1024;
+
+	// cells per agent the grid is allowed before its cells grow
+	constexpr size_t CellsPerAgent = 2;
+}
+
+Flocking::Flocking()
+	: m_CellSize(1.0f)
+	, m_Columns(0)
+	, m_Rows(0)
+{
+
+}
+
+
+void Flocking::Update(Registry& Scene, JobSystem& Jobs, const FlowField& Field, const LodScheduler& Lod, const FlockingSettings& Settings)
+{
+	auto  Movers	= Groups::Movers(Scene);
+	auto& Enemies	= Scene.storage<Tags::Enemy>();
+	auto& Paths		= Scene.storage<PathComponent>();
+
+	const SimScalar Reach = SimScalar(Settings.WaypointReach);
+
+	m_Agents.clear();
+
+	for (auto [Entity, Velocity, Acceleration, Transform] : Movers.each())
+	{
+		if (!Enemies.contains(Entity))
+			continue;
+
+		// agents not due are still neighbours of the ones that are
+		const bool Due = Lod.Due(Entity, Transform.m_Position);
+
+		// following moves a path on, so it happens here rather than in the parallel part
+		SimVector2 Seek;
+
+		if (Due && Paths.contains(Entity))
+			Paths.get(Entity).Follow(Transform.m_Position, Reach, Seek);
+
+		m_Agents.push_back(Agent{ Transform.m_Position, Velocity.m_Velocity, Seek, &Acceleration, 0, Due });
+	}
+
+	m_Active.clear();
+
+	if (m_Agents.empty())
+		return;
+
+	BuildGrid(Settings.Radius);
+
+	const uint32_t Chunks = static_cast<uint32_t>((m_Active.size() + ChunkSize - 1) / ChunkSize);
+
+	Jobs.ParallelFor(Chunks, [&](uint32_t Chunk)
+	{
+		const size_t First = Chunk * ChunkSize;
+
+		Steer(First, std::min(First + ChunkSize, m_Active.size()), Field, Settings);
+	});
+}
+
+
+void Flocking::BuildGrid(float Radius)
+{
+	Vector2 Min(m_Agents.front().Position);
+	Vector2 Max(Min);
+
+	for (const Agent& Each : m_Agents)
+	{
+		const Vector2 Position(Each.Position);
+
+		Min = Vector2(std::min(Min.x, Position.x), std::min(Min.y, Position.y));
+		Max = Vector2(std::max(Max.x, Position.x), std::max(Max.y, Position.y));
+	}
+
+	// a cell at least as big as the radius keeps every neighbour within the
+	// surrounding 3x3, bigger when the agents are too spread out for the cell budget
+	const Vector2	Extent		= Max - Min;
+	const float		MaxCells	= float(std::max<size_t>(1024, m_Agents.size() * CellsPerAgent));
+
+	m_Origin	= Min;
+	m_CellSize	= std::max({ Radius, std::sqrt(Extent.x * Extent.y / MaxCells), (Extent.x + Extent.y) / MaxCells });
+	m_Columns	= static_cast<int32_t>(Extent.x / m_CellSize) + 1;
+	m_Rows		= static_cast<int32_t>(Extent.y / m_CellSize) + 1;
+
+	const size_t Cells = size_t(m_Columns) * size_t(m_Rows);
+
+	m_Starts.assign(Cells + 1, 0);
+
+	for (Agent& Each : m_Agents)
+	{
+		Each.Cell = static_cast<uint32_t>(RowOf(Each.Position.y) * m_Columns + ColumnOf(Each.Position.x));
+		m_Starts[Each.Cell + 1]++;
+	}
+
+	for (size_t i = 0; i < Cells; i++)
+		m_Starts[i + 1] += m_Starts[i];
+
+	// stable, agents keep group order inside a cell so neighbour caps pick the same ones every run
+	m_Cursors.assign(m_Starts.begin(), m_Starts.end() - 1);
+	m_PositionX.resize(m_Agents.size());
+	m_PositionY.resize(m_Agents.size());
+	m_VelocityX.resize(m_Agents.size());
+	m_VelocityY.resize(m_Agents.size());
+	m_Seeks.resize(m_Agents.size());
+	m_Steering.resize(m_Agents.size());
+
+	for (const Agent& Each : m_Agents)
+	{
+		const uint32_t Slot = m_Cursors[Each.Cell]++;
+
+		m_PositionX[Slot]	= Each.Position.x;
+		m_PositionY[Slot]	= Each.Position.y;
+		m_VelocityX[Slot]	= Each.Velocity.x;
+		m_VelocityY[Slot]	= Each.Velocity.y;
+		m_Seeks[Slot]		= Each.Seek;
+		m_Steering[Slot]	= Each.Due ? Each.Steering : nullptr;
+	}
+
+	// steered in sorted order too, neighbouring agents share their cells' cache lines
+	for (uint32_t Slot = 0; Slot < m_Steering.size(); Slot++)
+	{
+		if (m_Steering[Slot])
+			m_Active.push_back(Slot);
+	}
+}
+
+
+void Flocking::Steer(size_t First, size_t Last, const FlowField& Field, const FlockingSettings& Settings) const
+{
+	const SimScalar Radius2				= SimScalar(Settings.Radius * Settings.Radius);
+	const SimScalar SeparationRadius2	= SimScalar(Settings.SeparationRadius * Settings.SeparationRadius);
+
+	const SimScalar Separation	= SimScalar(Settings.Separation);
+	const SimScalar Alignment	= SimScalar(Settings.Alignment);
+	const SimScalar Cohesion	= SimScalar(Settings.Cohesion);
+	const SimScalar Seek		= SimScalar(Settings.Seek);
+	const SimScalar SeekSpeed	= SimScalar(Settings.SeekSpeed);
+	const SimScalar MaxForce	= SimScalar(Settings.MaxForce);
+
+	// finished forces wait here to be clamped a batch at a time, lanes past
+	// Pending are left over from the last batch and never written back
+	float	ForceX[Simd::Vector2x8::Width]	= {};
+	float	ForceY[Simd::Vector2x8::Width]	= {};
+	size_t	Slots[Simd::Vector2x8::Width]	= {};
+	size_t	Pending							= 0;
+
+	auto Clamp = [&]()
+	{
+		const Simd::Float8 One		= Simd::Float8::Broadcast(1.0f);
+		const Simd::Float8 Tiny		= Simd::Float8::Broadcast(FLT_MIN);
+		const Simd::Float8 Limit	= Simd::Float8::Broadcast(Settings.MaxForce);
+
+		Simd::Vector2x8 Forces = Simd::Vector2x8::Load(ForceX, ForceY);
+
+		Forces = Forces * Simd::Min(One, Limit / Simd::Max(Forces.Magnitude(), Tiny));
+		Forces.Store(ForceX, ForceY);
+
+		for (size_t Lane = 0; Lane < Pending; Lane++)
+			m_Steering[Slots[Lane]]->m_Acceleration = SimVector2(SimScalar(ForceX[Lane]), SimScalar(ForceY[Lane]));
+
+		Pending = 0;
+	};
+
+	for (size_t k = First; k < Last; k++)
+	{
+		const size_t i = m_Active[k];
+
+		const SimVector2 Position(m_PositionX[i], m_PositionY[i]);
+		const SimVector2 Velocity(m_VelocityX[i], m_VelocityY[i]);
+
+		const int32_t Column	= ColumnOf(Position.x);
+		const int32_t Row		= RowOf(Position.y);
+
+		const int32_t FirstColumn	= std::max(Column - 1, 0);
+		const int32_t LastColumn	= std::min(Column + 1, m_Columns - 1);
+
+		SimVector2	Away;
+		SimVector2	Heading;
+		SimVector2	Centre;	// relative to Self, absolute positions could saturate a fixed point sum
+		int			Neighbours = 0;
+
+		// three neighbouring cells of a row are one range of the sorted agents
+		for (int32_t y = std::max(Row - 1, 0); y <= std::min(Row + 1, m_Rows - 1) && Neighbours < Settings.MaxNeighbours; y++)
+		{
+			const uint32_t Begin	= m_Starts[size_t(y) * m_Columns + FirstColumn];
+			const uint32_t End		= m_Starts[size_t(y) * m_Columns + LastColumn + 1];
+
+			for (uint32_t j = Begin; j < End && Neighbours < Settings.MaxNeighbours; j++)
+			{
+				if (j == i)
+					continue;
+
+				const SimVector2	Offset		= SimVector2(m_PositionX[j], m_PositionY[j]) - Position;
+				const SimScalar		Distance2	= Offset.MagnitudeSquared();
+
+				// corners of the 3x3 are further than the radius, and a far offset saturates instead of wrapping
+				if (!(Distance2 < Radius2))
+					continue;
+
+				// pushed away harder the closer it is, coincident agents can't tell which way
+				if (Distance2 < SeparationRadius2 && Distance2 > SimScalar())
+					Away -= Offset / Distance2;
+
+				Heading	+= SimVector2(m_VelocityX[j], m_VelocityY[j]);
+				Centre	+= Offset;
+				Neighbours++;
+			}
+		}
+
+		SimVector2 Force;
+
+		if (Neighbours > 0)
+		{
+			const SimScalar Count(static_cast<float>(Neighbours));
+
+			Force += Away * Separation;
+			Force += (Heading / Count - Velocity) * Alignment;
+			Force += (Centre / Count) * Cohesion;
+		}
+
+		const SimVector2 Path		= m_Seeks[i];
+		const SimVector2 Desired	= (Path.x != SimScalar() || Path.y != SimScalar() ? Path : Field.Direction(Position)) * SeekSpeed;
+
+		Force += (Desired - Velocity) * Seek;
+
+		// fixed point stays scalar, float lanes would cost it its bit identical results
+		if constexpr (std::is_same_v<SimScalar, float>)
+		{
+			ForceX[Pending]	= float(Force.x);
+			ForceY[Pending]	= float(Force.y);
+			Slots[Pending]	= i;
+
+			if (++Pending == Simd::Vector2x8::Width)
+				Clamp();
+		}
+		else
+		{
+			const SimScalar Length = Force.Magnitude();
+
+			if (Length > MaxForce)
+				Force = Force * (MaxForce / Length);
+
+			m_Steering[i]->m_Acceleration = Force;
+		}
+	}
+
+	if (Pending > 0)
+		Clamp();
+}
+
+
+int32_t Flocking::ColumnOf(SimScalar x) const
+{
+	return std::clamp(static_cast<int32_t>((float(x) - m_Origin.x) / m_CellSize), 0, m_Columns - 1);
+}
+
+int32_t Flocking::RowOf(SimScalar y) const
+{
+	return std::clamp(static_cast<int32_t>((float(y) - m_Origin.y) / m_CellSize), 0, m_Rows - 1);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "../JobSystem.hpp"
+#include "../Registry.hpp"
+#include "../Simulation.hpp"
+
+#include "FlowField.hpp"
+#include "LodScheduler.hpp"
+
+#include <cstdint>
+#include <vector>
+
+struct AccelerationComponent;
+
+struct FlockingSettings
+{
+	float	Radius				= 48.0f;	// neighbours further away are ignored, also the grid cell size
+	float	SeparationRadius	= 24.0f;	// neighbours closer than this push away
+	int		MaxNeighbours		= 16;		// caps the cost of an agent inside a dense clump
+
+	// weights of each rule, the sum is the acceleration written
+	float	Separation			= 4000.0f;
+	float	Alignment			= 2.0f;
+	float	Cohesion			= 1.0f;
+	float	Seek				= 1.5f;
+
+	float	SeekSpeed			= 120.0f;	// how fast an agent wants to follow the field
+	float	MaxForce			= 600.0f;	// acceleration is clamped to this
+
+	float	WaypointReach		= 16.0f;	// a waypoint of a path this close counts as reached
+};
+
+// boids for everything tagged Tags::Enemy in Groups::Movers, seeking along
+// the flow field towards its goal, or along its own path while it has a
+// PathComponent with waypoints left. Only agents the LodScheduler has due
+// are steered, the others keep their last acceleration.
+// Every update rebuilds a uniform grid over the bounds of the agents with a
+// counting sort, agents are copied in row major cell order so the three
+// cells of a neighbour row are one contiguous range. Steering is then
+// computed in parallel chunks, each agent reading only the sorted copy and
+// writing only its own acceleration, which the movement system turns into
+// velocity. Agents spread far apart grow the cells instead of the grid.
+// All of it counts in SimScalar, fixed point builds stay deterministic.
+// Float builds clamp the finished forces eight agents at a time.
+
+class Flocking
+{
+
+public:
+
+	Flocking();
+	~Flocking() = default;
+
+
+public:
+
+	void Update(Registry& Scene, JobSystem& Jobs, const FlowField& Field, const LodScheduler& Lod, const FlockingSettings& Settings);
+
+	// agents steered by the last update
+	size_t Steered() const { return m_Active.size(); }
+
+
+private:
+
+	struct Agent
+	{
+		SimVector2				Position;
+		SimVector2				Velocity;
+		SimVector2				Seek;	// along the agent's own path, zero to follow the field
+		AccelerationComponent*	Steering;
+		uint32_t				Cell;
+		bool					Due;
+	};
+
+	void BuildGrid(float Radius);
+	void Steer(size_t First, size_t Last, const FlowField& Field, const FlockingSettings& Settings) const;
+
+	int32_t ColumnOf(SimScalar x) const;
+	int32_t RowOf(SimScalar y) const;
+
+
+private:
+
+	// agents in group order, then their positions and velocities sorted by
+	// cell as separate x and y arrays, all a neighbour query reads
+	std::vector<Agent>		m_Agents;
+	std::vector<SimScalar>	m_PositionX;
+	std::vector<SimScalar>	m_PositionY;
+	std::vector<SimScalar>	m_VelocityX;
+	std::vector<SimScalar>	m_VelocityY;
+	std::vector<SimVector2>	m_Seeks;
+	std::vector<AccelerationComponent*>	m_Steering;
+
+	// slots of the agents due this update, ascending. Steering is null for the others
+	std::vector<uint32_t>	m_Active;
+
+	// first sorted agent of every cell, one past the end at the back
+	std::vector<uint32_t>	m_Starts;
+	std::vector<uint32_t>	m_Cursors;
+
+	// grid over the agents' bounds, rebuilt every update
+	Vector2					m_Origin;
+	float					m_CellSize;
+	int32_t					m_Columns;
+	int32_t					m_Rows;
+
+};
@@ -0,0 +1,167 @@
+#include "FlowField.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+	constexpr float Diagonal = 0.70710678f;
+
+	// unit vectors along NavigationGrid's steps
+	const SimVector2 StepDirection[8] =
+	{
+		SimVector2(Vector2(1, 0)),	SimVector2(Vector2(0, 1)),	SimVector2(Vector2(-1, 0)),	SimVector2(Vector2(0, -1)),
+		SimVector2(Vector2(Diagonal, Diagonal)),	SimVector2(Vector2(-Diagonal, Diagonal)),
+		SimVector2(Vector2(-Diagonal, -Diagonal)),	SimVector2(Vector2(Diagonal, -Diagonal)),
+	};
+
+	constexpr uint8_t	NoDirection	= 8;
+	constexpr uint32_t	Unreachable	= std::numeric_limits<uint32_t>::max();
+
+	// rows a job points
+	constexpr int32_t BandRows = 16;
+}
+
+FlowField::FlowField()
+	: m_Grid(nullptr)
+	, m_GridVersion(0)
+	, m_GoalCell(-1)
+	, m_Rebuilds(0)
+{
+
+}
+
+
+void FlowField::Update(const NavigationGrid& Grid, JobSystem& Jobs, SimVector2 Goal)
+{
+	m_Goal = Goal;
+
+	const int32_t GoalCell = Grid.CellOf(Goal);
+
+	if (m_Grid == &Grid && m_GridVersion == Grid.Version() && GoalCell == m_GoalCell)
+		return;
+
+	m_Grid			= &Grid;
+	m_GridVersion	= Grid.Version();
+	m_GoalCell		= GoalCell;
+	m_Rebuilds++;
+
+	m_Costs.resize(Grid.Cells().size());
+	m_Directions.resize(Grid.Cells().size());
+
+	// a goal off the grid leaves every agent on the straight line
+	if (GoalCell < 0)
+	{
+		std::fill(m_Directions.begin(), m_Directions.end(), NoDirection);
+		return;
+	}
+
+	Integrate();
+	BuildDirections(Jobs);
+}
+
+
+SimVector2 FlowField::Direction(SimVector2 Position) const
+{
+	const int32_t Cell = m_Grid ? m_Grid->CellOf(Position) : -1;
+
+	if (Cell >= 0 && m_Directions[Cell] != NoDirection)
+		return StepDirection[m_Directions[Cell]];
+
+	return (m_Goal - Position).NormalizeSafe();
+}
+
+
+void FlowField::Integrate()
+{
+	const int32_t Columns = m_Grid->Columns();
+
+	std::fill(m_Costs.begin(), m_Costs.end(), Unreachable);
+
+	for (std::vector<uint32_t>& Bucket : m_Open)
+		Bucket.clear();
+
+	m_Costs[m_GoalCell] = 0;
+	m_Open[0].push_back(uint32_t(m_GoalCell));
+
+	size_t Pending = 1;
+
+	// costs only ever grow by 2 or 3, the bucket being drained never gets pushed to
+	for (uint32_t Cost = 0; Pending > 0; Cost++)
+	{
+		std::vector<uint32_t>& Bucket = m_Open[Cost % 4];
+
+		for (const uint32_t Cell : Bucket)
+		{
+			Pending--;
+
+			// reached cheaper after it was queued
+			if (m_Costs[Cell] != Cost)
+				continue;
+
+			const int32_t x = int32_t(Cell % uint32_t(Columns));
+			const int32_t y = int32_t(Cell / uint32_t(Columns));
+
+			for (int Step = 0; Step < 8; Step++)
+			{
+				if (!m_Grid->CanStep(x, y, Step))
+					continue;
+
+				const size_t	Next		= size_t(y + NavigationGrid::StepY[Step]) * Columns + (x + NavigationGrid::StepX[Step]);
+				const uint32_t	NextCost	= Cost + NavigationGrid::StepCost[Step];
+
+				if (NextCost < m_Costs[Next])
+				{
+					m_Costs[Next] = NextCost;
+					m_Open[NextCost % 4].push_back(uint32_t(Next));
+					Pending++;
+				}
+			}
+		}
+
+		Bucket.clear();
+	}
+}
+
+
+void FlowField::BuildDirections(JobSystem& Jobs)
+{
+	const int32_t Columns	= m_Grid->Columns();
+	const int32_t Rows		= m_Grid->Rows();
+
+	const uint32_t Bands = static_cast<uint32_t>((Rows + BandRows - 1) / BandRows);
+
+	Jobs.ParallelFor(Bands, [&](uint32_t Band)
+	{
+		const int32_t FirstRow	= int32_t(Band) * BandRows;
+		const int32_t LastRow	= std::min(FirstRow + BandRows, Rows) - 1;
+
+		for (int32_t y = FirstRow; y <= LastRow; y++)
+		{
+			for (int32_t x = 0; x < Columns; x++)
+			{
+				const size_t Cell = size_t(y) * Columns + x;
+
+				uint32_t	Best		= m_Costs[Cell];
+				uint8_t		Direction	= NoDirection;
+
+				// blocked and unreachable cells stay at Unreachable, the goal at 0, neither points anywhere
+				for (int Step = 0; Step < 8 && Best != Unreachable; Step++)
+				{
+					if (!m_Grid->CanStep(x, y, Step))
+						continue;
+
+					const uint32_t Cost = m_Costs[size_t(y + NavigationGrid::StepY[Step]) * Columns + (x + NavigationGrid::StepX[Step])];
+
+					if (Cost < Best)
+					{
+						Best		= Cost;
+						Direction	= uint8_t(Step);
+					}
+				}
+
+				m_Directions[Cell] = Direction;
+			}
+		}
+	});
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../JobSystem.hpp"
+#include "../Simulation.hpp"
+
+#include "NavigationGrid.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// one path search shared by every enemy.
+// The integration field is the cost of the cheapest 8-connected path from
+// every cell of the navigation grid to the goal's cell, a Dijkstra over
+// small integer costs (bucket queue, linear in the cell count), diagonals
+// never cut a blocked corner. The direction field then points every cell
+// at its cheapest neighbour, so an agent finds its way with one lookup
+// wherever it stands. Nothing is rebuilt until the goal enters another
+// cell or the grid changed.
+
+class FlowField
+{
+
+public:
+
+	FlowField();
+	~FlowField() = default;
+
+
+public:
+
+	void Update(const NavigationGrid& Grid, JobSystem& Jobs, SimVector2 Goal);
+
+	// unit vector towards the goal around obstacles. A straight line in
+	// the goal's cell, outside the grid and where the goal can't be reached
+	SimVector2 Direction(SimVector2 Position) const;
+
+	SimVector2	Goal()		const { return m_Goal; }
+	uint32_t	Rebuilds()	const { return m_Rebuilds; }
+
+
+private:
+
+	void Integrate();
+	void BuildDirections(JobSystem& Jobs);
+
+
+private:
+
+	// the grid of the last update, and which version of it the field was built on
+	const NavigationGrid*	m_Grid;
+	uint32_t				m_GridVersion;
+
+	std::vector<uint32_t>	m_Costs;
+	std::vector<uint8_t>	m_Directions;	// index of the neighbour to move to
+
+	// Dijkstra's open list, ring of buckets by cost
+	std::vector<uint32_t>	m_Open[4];
+
+	SimVector2				m_Goal;
+	int32_t					m_GoalCell;
+	uint32_t				m_Rebuilds;
+
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../Components/AccelerationComponent.hpp"
+#include "../Components/QuadColliderComponent.hpp"
+#include "../Components/QuadComponent.hpp"
+#include "../Components/Tags.hpp"
+#include "../Components/TransformComponent.hpp"
+#include "../Components/VelocityComponent.hpp"
+
+#include "../Registry.hpp"
+
+// owning groups for the hot loops.
+// a group keeps the entities it matches packed at the front of the
+// storages it owns, in the same order, so iterating it walks plain arrays
+// instead of going through the sparse sets entity by entity. A storage can
+// only be owned by one group, keep every owning group in here.
+
+namespace Groups
+{
+	// transforms, quads and colliders of everything tagged as an enemy
+	inline auto Enemies(Registry& Scene)
+	{
+		return Scene.group<TransformComponent, QuadComponent, QuadColliderComponent>(entt::get<Tags::Enemy>);
+	}
+
+	// velocities and accelerations of everything that moves, side by side.
+	// Transforms are owned by Enemies, they're looked up
+	inline auto Movers(Registry& Scene)
+	{
+		return Scene.group<VelocityComponent, AccelerationComponent>(entt::get<TransformComponent>);
+	}
+}
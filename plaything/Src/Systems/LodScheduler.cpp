@@ -0,0 +1,53 @@
+#include "LodScheduler.hpp"
+
+#include <algorithm>
+
+LodScheduler::LodScheduler()
+	: m_Tick(0)
+	, m_Starts{}
+	, m_Levels(1)
+	, m_VisibleLevel(0)
+{
+
+}
+
+
+void LodScheduler::Begin(uint64_t Tick, SimVector2 Focus, Vector2 ViewMin, Vector2 ViewMax, const LodSettings& Settings)
+{
+	m_Tick		= Tick;
+	m_Focus		= Vector2(Focus);
+	m_ViewMin	= ViewMin;
+	m_ViewMax	= ViewMax;
+
+	m_Levels		= std::clamp(Settings.Levels, 1, MaxLevels);
+	m_VisibleLevel	= std::clamp(Settings.VisibleLevel, 0, m_Levels - 1);
+
+	float Start = Settings.NearRadius;
+
+	for (int Level = 1; Level < m_Levels; Level++)
+	{
+		m_Starts[Level - 1]	= Start * Start;
+		Start				*= 2.0f;
+	}
+}
+
+
+int LodScheduler::LevelOf(SimVector2 Position) const
+{
+	// in float, a fixed point distance squared saturates a few hundred units out
+	const Vector2	Point		= Vector2(Position);
+	const float		Distance2	= (Point - m_Focus).MagnitudeSquared();
+
+	int Level = 0;
+
+	while (Level + 1 < m_Levels && Distance2 >= m_Starts[Level])
+		Level++;
+
+	const bool Visible = Point.x >= m_ViewMin.x && Point.y >= m_ViewMin.y && Point.x < m_ViewMax.x && Point.y < m_ViewMax.y;
+
+	// on screen capped, off screen never at full rate
+	if (Visible)
+		return std::min(Level, m_VisibleLevel);
+
+	return std::max(Level, std::min(1, m_Levels - 1));
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../Simulation.hpp"
+
+#include <cstdint>
+
+struct LodSettings
+{
+	float	NearRadius		= 320.0f;	// full rate within this of the focus
+	int		Levels			= 5;		// level n updates every 2^n ticks, and starts twice as far out as n - 1
+	int		VisibleLevel	= 1;		// agents in view never go further than this level
+};
+
+// how often an agent's AI runs, by its distance to the focus (the player).
+// Level 0 runs every tick, every level further out half as often. Which of
+// its ticks an agent runs on is offset by its entity index, so each tick
+// only takes its share of every level and the cost stays flat instead of
+// spiking every 2^n ticks. Whatever the AI writes is a rate (an
+// acceleration) the movement integrates every tick, holding it for the
+// skipped ticks is what scaling its delta time by the period would do.
+// Nothing is stored per agent, a level is worked out from the position
+// when asked.
+
+class LodScheduler
+{
+
+public:
+
+	static constexpr int MaxLevels = 8;
+
+
+public:
+
+	LodScheduler();
+	~LodScheduler() = default;
+
+
+public:
+
+	// once per tick before any Due, View is the part of the world on screen
+	void Begin(uint64_t Tick, SimVector2 Focus, Vector2 ViewMin, Vector2 ViewMax, const LodSettings& Settings);
+
+	int LevelOf(SimVector2 Position) const;
+
+	// whether the agent's AI runs this tick
+	bool Due(entt::entity Entity, SimVector2 Position) const
+	{
+		const uint64_t Period = uint64_t(1) << LevelOf(Position);
+
+		return ((m_Tick + entt::to_entity(Entity)) & (Period - 1)) == 0;
+	}
+
+
+private:
+
+	uint64_t	m_Tick;
+	Vector2		m_Focus;
+	Vector2		m_ViewMin;
+	Vector2		m_ViewMax;
+
+	// squared distance where every level past 0 starts
+	float		m_Starts[MaxLevels];
+	int			m_Levels;
+	int			m_VisibleLevel;
+
+};
@@ -0,0 +1,109 @@
+#include "MovementSystem.hpp"
+
+#include "Groups.hpp"
+
+#include "../Simd.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <type_traits>
+
+namespace
+{
+	constexpr size_t PageSize = entt::component_traits<VelocityComponent>::page_size;
+
+	static_assert(entt::component_traits<AccelerationComponent>::page_size == PageSize, "Velocity and acceleration pages line up");
+	static_assert(sizeof(VelocityComponent) == sizeof(SimVector2) && sizeof(AccelerationComponent) == sizeof(SimVector2), "Pages are read as plain x, y pairs");
+
+	void IntegrateVelocity(SimVector2& Velocity, const SimVector2& Acceleration, SimScalar Dt, SimScalar Keep, SimScalar MaxSpeed)
+	{
+		Velocity = (Velocity + Acceleration * Dt) * Keep;
+
+		const SimScalar Speed = Velocity.Magnitude();
+
+		if (Speed > MaxSpeed)
+			Velocity = Velocity * (MaxSpeed / Speed);
+	}
+
+	// Count velocities of one page. Fixed point stays scalar, its saturating
+	// multiply has no SSE2 equivalent
+	void IntegrateVelocities(VelocityComponent* Velocities, const AccelerationComponent* Accelerations, size_t Count, float Dt, float Keep, float MaxSpeed)
+	{
+		size_t First = 0;
+
+		if constexpr (std::is_same_v<SimScalar, float>)
+		{
+			// x and y interleaved, four velocities per Float8
+			float*			V = reinterpret_cast<float*>(Velocities);
+			const float*	A = reinterpret_cast<const float*>(Accelerations);
+
+			const Simd::Float8 Dt8		= Simd::Float8::Broadcast(Dt);
+			const Simd::Float8 Keep8	= Simd::Float8::Broadcast(Keep);
+			const Simd::Float8 Max8		= Simd::Float8::Broadcast(MaxSpeed);
+			const Simd::Float8 One8		= Simd::Float8::Broadcast(1.0f);
+			const Simd::Float8 Tiny8	= Simd::Float8::Broadcast(FLT_MIN);
+
+			First = Count - Count % 4;
+
+			for (size_t i = 0; i < First * 2; i += Simd::Float8::Width)
+			{
+				Simd::Float8 Velocity = Simd::MultiplyAdd(Simd::Float8::Load(A + i), Dt8, Simd::Float8::Load(V + i)) * Keep8;
+
+				// both lanes of a pair get x * x + y * y
+				const Simd::Float8 Squared	= Velocity * Velocity;
+				const Simd::Float8 Speed	= Simd::Sqrt(Squared + Simd::SwapPairs(Squared));
+
+				Velocity = Velocity * Simd::Min(One8, Max8 / Simd::Max(Speed, Tiny8));
+				Velocity.Store(V + i);
+			}
+		}
+
+		for (size_t i = First; i < Count; i++)
+			IntegrateVelocity(Velocities[i].m_Velocity, Accelerations[i].m_Acceleration, SimScalar(Dt), SimScalar(Keep), SimScalar(MaxSpeed));
+	}
+}
+
+namespace Systems
+{
+	void IntegrateMovement(Registry& Scene, float Dt, const MovementSettings& Settings)
+	{
+		auto Movers = Groups::Movers(Scene);
+
+		auto& Velocities	= Scene.storage<VelocityComponent>();
+		auto& Accelerations	= Scene.storage<AccelerationComponent>();
+		auto& Transforms	= Scene.storage<TransformComponent>();
+
+		const float Keep		= std::max(0.0f, 1.0f - Settings.Damping * Dt);
+		const float MaxSpeed	= Settings.MaxSpeed > 0.0f ? Settings.MaxSpeed : FLT_MAX;
+
+		const SimScalar Step(Dt);
+
+		// the group owns both storages, its entities are their front in the same order
+		const size_t			Count		= Movers.size();
+		const entt::entity*		Entities	= Velocities.data();
+
+		for (size_t Begin = 0; Begin < Count; Begin += PageSize)
+		{
+			const size_t Page	= Begin / PageSize;
+			const size_t Length	= std::min(PageSize, Count - Begin);
+
+			VelocityComponent* const PageVelocities = Velocities.raw()[Page];
+
+			IntegrateVelocities(PageVelocities, Accelerations.raw()[Page], Length, Dt, Keep, MaxSpeed);
+
+			// resting movers don't dirty their transforms
+			for (size_t i = 0; i < Length; i++)
+			{
+				const SimVector2& Velocity = PageVelocities[i].m_Velocity;
+
+				if (Velocity == SimVector2())
+					continue;
+
+				TransformComponent& Transform = Transforms.get(Entities[Begin + i]);
+
+				Transform.m_Position	+= Velocity * Step;
+				Transform.m_Dirty		= true;
+			}
+		}
+	}
+}
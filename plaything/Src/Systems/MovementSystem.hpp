@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../Registry.hpp"
+
+namespace Systems
+{
+	struct MovementSettings
+	{
+		float	Damping		= 0.0f;	// fraction of the velocity lost per second
+		float	MaxSpeed	= 0.0f;	// units per second, 0 for no limit
+	};
+
+	// semi-implicit Euler over Groups::Movers. Velocity += acceleration * dt,
+	// damped and clamped to MaxSpeed, then position += the new velocity * dt.
+	// Velocities are integrated four at a time straight out of the storage
+	// pages, transforms that moved are flagged dirty so collider bounds and
+	// attachments follow.
+	void IntegrateMovement(Registry& Scene, float Dt, const MovementSettings& Settings);
+}
@@ -0,0 +1,132 @@
+#include "NavigationGrid.hpp"
+
+#include "../Components/QuadColliderComponent.hpp"
+#include "../Components/Tags.hpp"
+#include "../Components/TransformComponent.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// rows a job rasterizes
+	constexpr int32_t BandRows = 16;
+}
+
+NavigationGrid::NavigationGrid()
+	: m_Origin()
+	, m_CellSize(1.0f)
+	, m_Columns(0)
+	, m_Rows(0)
+	, m_Dirty(true)
+	, m_Version(0)
+{
+
+}
+
+
+void NavigationGrid::Connect(Registry& Scene)
+{
+	Scene.on_construct<Tags::Static>().connect<&NavigationGrid::OnStaticChanged>(this);
+	Scene.on_destroy<Tags::Static>().connect<&NavigationGrid::OnStaticChanged>(this);
+
+	Scene.on_construct<QuadColliderComponent>().connect<&NavigationGrid::OnColliderChanged>(this);
+	Scene.on_update<QuadColliderComponent>().connect<&NavigationGrid::OnColliderChanged>(this);
+	Scene.on_destroy<QuadColliderComponent>().connect<&NavigationGrid::OnColliderChanged>(this);
+}
+
+
+void NavigationGrid::Disconnect(Registry& Scene)
+{
+	Scene.on_construct<Tags::Static>().disconnect(this);
+	Scene.on_destroy<Tags::Static>().disconnect(this);
+
+	Scene.on_construct<QuadColliderComponent>().disconnect(this);
+	Scene.on_update<QuadColliderComponent>().disconnect(this);
+	Scene.on_destroy<QuadColliderComponent>().disconnect(this);
+}
+
+
+void NavigationGrid::Resize(Vector2 Origin, int32_t Columns, int32_t Rows, float CellSize)
+{
+	m_Origin	= Origin;
+	m_CellSize	= CellSize;
+	m_Columns	= std::max(Columns, 0);
+	m_Rows		= std::max(Rows, 0);
+
+	m_Blocked.assign(size_t(m_Columns) * size_t(m_Rows), 0);
+
+	m_Dirty = true;
+}
+
+
+void NavigationGrid::Update(Registry& Scene, JobSystem& Jobs)
+{
+	if (!m_Dirty)
+		return;
+
+	m_Dirty = false;
+	m_Version++;
+
+	m_Obstacles.clear();
+
+	for (auto [Entity, Transform, Collider] : Scene.view<TransformComponent, QuadColliderComponent, Tags::Static>().each())
+	{
+		const Vector2 Min(Transform.m_Position + Collider.m_Offset);
+
+		m_Obstacles.push_back(Min);
+		m_Obstacles.push_back(Min + Vector2(Collider.m_Size));
+	}
+
+	// every band clears its rows and marks what overlaps them, bands never share a cell
+	const uint32_t Bands = static_cast<uint32_t>((m_Rows + BandRows - 1) / BandRows);
+
+	Jobs.ParallelFor(Bands, [this](uint32_t Band)
+	{
+		const int32_t FirstRow	= int32_t(Band) * BandRows;
+		const int32_t LastRow	= std::min(FirstRow + BandRows, m_Rows) - 1;
+
+		std::fill(m_Blocked.begin() + size_t(FirstRow) * m_Columns, m_Blocked.begin() + size_t(LastRow + 1) * m_Columns, uint8_t(0));
+
+		for (size_t i = 0; i < m_Obstacles.size(); i += 2)
+		{
+			const Vector2 Min = (m_Obstacles[i] - m_Origin) / m_CellSize;
+			const Vector2 Max = (m_Obstacles[i + 1] - m_Origin) / m_CellSize;
+
+			// cells the box overlaps, a box ending on a cell edge doesn't block the next one
+			const int32_t Left		= static_cast<int32_t>(std::clamp(std::floor(Min.x), 0.0f, float(m_Columns)));
+			const int32_t Right		= static_cast<int32_t>(std::clamp(std::ceil(Max.x), 0.0f, float(m_Columns))) - 1;
+			const int32_t Top		= std::max(static_cast<int32_t>(std::clamp(std::floor(Min.y), 0.0f, float(m_Rows))), FirstRow);
+			const int32_t Bottom	= std::min(static_cast<int32_t>(std::clamp(std::ceil(Max.y), 0.0f, float(m_Rows))) - 1, LastRow);
+
+			for (int32_t y = Top; y <= Bottom; y++)
+				for (int32_t x = Left; x <= Right; x++)
+					m_Blocked[size_t(y) * m_Columns + x] = 1;
+		}
+	});
+}
+
+
+int32_t NavigationGrid::CellOf(SimVector2 Position) const
+{
+	const Vector2 Local = (Vector2(Position) - m_Origin) / m_CellSize;
+
+	if (!(Local.x >= 0.0f && Local.y >= 0.0f && Local.x < float(m_Columns) && Local.y < float(m_Rows)))
+		return -1;
+
+	return static_cast<int32_t>(Local.y) * m_Columns + static_cast<int32_t>(Local.x);
+}
+
+
+void NavigationGrid::OnStaticChanged(Registry& Scene, entt::entity Entity)
+{
+	m_Dirty = true;
+}
+
+
+void NavigationGrid::OnColliderChanged(Registry& Scene, entt::entity Entity)
+{
+	// enemies come and go every tick, only static colliders are obstacles
+	if (Scene.all_of<Tags::Static>(Entity))
+		m_Dirty = true;
+}
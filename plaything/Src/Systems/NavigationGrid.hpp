@@ -0,0 +1,107 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../JobSystem.hpp"
+#include "../Registry.hpp"
+#include "../Simulation.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// which cells of the level can be walked, what every path search runs on.
+// Cells overlapped by a static collider are blocked. Static colliders are
+// watched through the registry signals and rasterized again (in parallel
+// row bands) on the next update after one of them changed, Version counts
+// the rebuilds so searches know when what they derived went stale.
+
+class NavigationGrid
+{
+
+public:
+
+	// the 8 neighbours of a cell, straight ones first so they win ties.
+	// Costs are 2 straight and 3 diagonal, 3/2 is close enough to the
+	// square root of 2 and keeps every cost an integer
+	static constexpr int32_t	StepX[8]	= { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static constexpr int32_t	StepY[8]	= { 0, 1, 0, -1, 1, 1, -1, -1 };
+	static constexpr uint32_t	StepCost[8]	= { 2, 2, 2, 2, 3, 3, 3, 3 };
+
+
+public:
+
+	NavigationGrid();
+	~NavigationGrid() = default;
+
+
+public:
+
+	void Connect(Registry& Scene);
+	void Disconnect(Registry& Scene);
+
+	// covers Columns x Rows cells of CellSize from Origin
+	void Resize(Vector2 Origin, int32_t Columns, int32_t Rows, float CellSize);
+
+	// rasterizes everything again on the next update, for when statics
+	// were written to behind the signals' back
+	void Invalidate() { m_Dirty = true; }
+
+	void Update(Registry& Scene, JobSystem& Jobs);
+
+
+public:
+
+	Vector2		Origin()	const { return m_Origin; }
+	float		CellSize()	const { return m_CellSize; }
+	int32_t		Columns()	const { return m_Columns; }
+	int32_t		Rows()		const { return m_Rows; }
+	uint32_t	Version()	const { return m_Version; }
+
+	const std::vector<uint8_t>& Cells() const { return m_Blocked; }
+
+	// -1 outside the grid
+	int32_t CellOf(SimVector2 Position) const;
+
+	// anything outside the grid is blocked
+	bool Blocked(int32_t x, int32_t y) const
+	{
+		return x < 0 || y < 0 || x >= m_Columns || y >= m_Rows || m_Blocked[size_t(y) * m_Columns + x];
+	}
+
+	// diagonals never squeeze between two blocked cells
+	bool CanStep(int32_t x, int32_t y, int Step) const
+	{
+		const int32_t Nx = x + StepX[Step];
+		const int32_t Ny = y + StepY[Step];
+
+		return !Blocked(Nx, Ny) && (Step < 4 || (!Blocked(Nx, y) && !Blocked(x, Ny)));
+	}
+
+	Vector2 CentreOf(int32_t x, int32_t y) const
+	{
+		return m_Origin + Vector2((float(x) + 0.5f) * m_CellSize, (float(y) + 0.5f) * m_CellSize);
+	}
+
+
+private:
+
+	void OnStaticChanged(Registry& Scene, entt::entity Entity);
+	void OnColliderChanged(Registry& Scene, entt::entity Entity);
+
+
+private:
+
+	Vector2					m_Origin;
+	float					m_CellSize;
+	int32_t					m_Columns;
+	int32_t					m_Rows;
+
+	std::vector<uint8_t>	m_Blocked;
+
+	// static collider bounds in float, gathered once per rasterization
+	std::vector<Vector2>	m_Obstacles;
+
+	bool					m_Dirty;
+	uint32_t				m_Version;
+
+};
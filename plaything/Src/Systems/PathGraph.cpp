@@ -0,0 +1,595 @@
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace
+{
+	constexpr uint32_t NoCell		= std::numeric_limits<uint32_t>::max();
+	constexpr uint32_t Unreached	= std::numeric_limits<uint32_t>::max();
+
+	// open runs along a border longer than this get an entrance at both ends
+	constexpr int32_t LongEntrance = 6;
+}
+
+
+void PathGraph::SearchSpace::Fit(size_t Cells, size_t Nodes)
+{
+	if (m_CellStamp.size() != Cells)
+	{
+		m_CellCost.resize(Cells);
+		m_CellParent.resize(Cells);
+		m_CellStamp.assign(Cells, 0);
+	}
+
+	if (m_NodeStamp.size() != Nodes)
+	{
+		m_NodeCost.resize(Nodes);
+		m_NodeParent.resize(Nodes);
+		m_NodeStamp.assign(Nodes, 0);
+	}
+}
+
+
+void PathGraph::SearchSpace::NextQuery()
+{
+	// once every four billion searches the stamps start over
+	if (++m_Stamp == 0)
+	{
+		std::fill(m_CellStamp.begin(), m_CellStamp.end(), 0);
+		std::fill(m_NodeStamp.begin(), m_NodeStamp.end(), 0);
+
+		m_Stamp = 1;
+	}
+}
+
+
+PathGraph::PathGraph()
+	: m_Origin()
+	, m_CellSize(1.0f)
+	, m_Columns(0)
+	, m_Rows(0)
+	, m_ClustersX(0)
+	, m_ClustersY(0)
+	, m_CacheHits(0)
+	, m_CacheMisses(0)
+{
+
+}
+
+
+void PathGraph::Build(const NavigationGrid& Grid)
+{
+	m_Origin	= Grid.Origin();
+	m_CellSize	= Grid.CellSize();
+	m_Columns	= Grid.Columns();
+	m_Rows		= Grid.Rows();
+	m_Blocked	= Grid.Cells();
+
+	m_ClustersX = (m_Columns + ClusterSize - 1) / ClusterSize;
+	m_ClustersY = (m_Rows + ClusterSize - 1) / ClusterSize;
+
+	m_Nodes.clear();
+	m_Edges.clear();
+	m_EdgeCells.clear();
+
+	std::vector<std::vector<Edge>>	Edges;
+	std::vector<int32_t>			NodeOfCell(m_Blocked.size(), -1);
+
+	// the right and bottom border of every cluster, the others are some cluster's right or bottom
+	for (int32_t Cy = 0; Cy < m_ClustersY; Cy++)
+	{
+		for (int32_t Cx = 0; Cx < m_ClustersX; Cx++)
+		{
+			const int32_t Left	= Cx * ClusterSize;
+			const int32_t Top	= Cy * ClusterSize;
+
+			if (Cx + 1 < m_ClustersX)
+				AddEntrances(Left + ClusterSize - 1, Top, 0, 1, std::min(ClusterSize, m_Rows - Top), Edges, NodeOfCell);
+
+			if (Cy + 1 < m_ClustersY)
+				AddEntrances(Left, Top + ClusterSize - 1, 1, 0, std::min(ClusterSize, m_Columns - Left), Edges, NodeOfCell);
+		}
+	}
+
+	const uint32_t Clusters = uint32_t(m_ClustersX * m_ClustersY);
+
+	m_ClusterFirst.assign(size_t(Clusters) + 1, 0);
+
+	for (const Node& Each : m_Nodes)
+		m_ClusterFirst[Each.Cluster + 1]++;
+
+	for (uint32_t i = 0; i < Clusters; i++)
+		m_ClusterFirst[i + 1] += m_ClusterFirst[i];
+
+	m_ClusterNodes.resize(m_Nodes.size());
+
+	std::vector<uint32_t> Cursors(m_ClusterFirst.begin(), m_ClusterFirst.end() - 1);
+
+	for (uint32_t i = 0; i < m_Nodes.size(); i++)
+		m_ClusterNodes[Cursors[m_Nodes[i].Cluster]++] = i;
+
+	SearchSpace Space;
+	Space.Fit(m_Blocked.size(), m_Nodes.size() + 1);
+
+	for (uint32_t Cluster = 0; Cluster < Clusters; Cluster++)
+		LinkCluster(Space, Cluster, Edges);
+
+	for (uint32_t i = 0; i < m_Nodes.size(); i++)
+	{
+		m_Nodes[i].FirstEdge	= uint32_t(m_Edges.size());
+		m_Nodes[i].EdgeCount	= uint32_t(Edges[i].size());
+
+		m_Edges.insert(m_Edges.end(), Edges[i].begin(), Edges[i].end());
+	}
+
+	ClearCache();
+}
+
+
+bool PathGraph::FindPath(SearchSpace& Space, SimVector2 Start, SimVector2 Goal, std::vector<SimVector2>& Waypoints, Route& Searched) const
+{
+	Waypoints.clear();
+	Searched.Searched = false;
+
+	const int32_t StartCell	= CellOf(Start);
+	const int32_t GoalCell	= CellOf(Goal);
+
+	if (StartCell < 0 || GoalCell < 0 || m_Blocked[StartCell] || m_Blocked[GoalCell])
+		return false;
+
+	Space.Fit(m_Blocked.size(), m_Nodes.size() + 1);
+
+	const uint32_t StartCluster	= ClusterOf(uint32_t(StartCell));
+	const uint32_t GoalCluster	= ClusterOf(uint32_t(GoalCell));
+
+	bool Found = false;
+
+	// within one cluster the direct search is all it takes, unless the way round leaves it
+	if (StartCluster == GoalCluster && SearchCells(Space, uint32_t(StartCell), uint32_t(GoalCell), AreaOf(StartCluster)))
+	{
+		Space.m_Cells.assign(1, uint32_t(StartCell));
+		AppendCells(Space, uint32_t(StartCell), uint32_t(GoalCell));
+
+		Found = true;
+	}
+
+	if (!Found)
+	{
+		const uint64_t Key = (uint64_t(StartCluster) << 32) | GoalCluster;
+
+		bool Cached = false;
+
+		if (auto It = m_Cache.find(Key); It != m_Cache.end())
+		{
+			Space.m_Route.assign(It->second.begin(), It->second.end());
+			Cached = true;
+		}
+
+		// a cached route can start or end in a part of the cluster this query can't reach
+		if (Cached && RefineRoute(Space, uint32_t(StartCell), uint32_t(GoalCell)))
+		{
+			m_CacheHits.fetch_add(1, std::memory_order_relaxed);
+			Found = true;
+		}
+		else
+		{
+			m_CacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+			if (!SearchRoute(Space, uint32_t(StartCell), uint32_t(GoalCell)))
+				return false;
+
+			Searched.Key		= Key;
+			Searched.Searched	= true;
+			Searched.Nodes.assign(Space.m_Route.begin(), Space.m_Route.end());
+
+			Found = RefineRoute(Space, uint32_t(StartCell), uint32_t(GoalCell));
+		}
+	}
+
+	if (!Found)
+		return false;
+
+	// only the cells where the path turns
+	const auto& Cells = Space.m_Cells;
+
+	for (size_t i = 1; i + 1 < Cells.size(); i++)
+	{
+		const int32_t In	= int32_t(Cells[i]) - int32_t(Cells[i - 1]);
+		const int32_t Out	= int32_t(Cells[i + 1]) - int32_t(Cells[i]);
+
+		if (In == Out)
+			continue;
+
+		const int32_t x = int32_t(Cells[i] % uint32_t(m_Columns));
+		const int32_t y = int32_t(Cells[i] / uint32_t(m_Columns));
+
+		Waypoints.emplace_back(m_Origin + Vector2((float(x) + 0.5f) * m_CellSize, (float(y) + 0.5f) * m_CellSize));
+	}
+
+	Waypoints.push_back(Goal);
+
+	return true;
+}
+
+
+void PathGraph::Learn(const Route& Searched)
+{
+	if (!Searched.Searched || m_Cache.contains(Searched.Key))
+		return;
+
+	if (m_Cache.size() >= CacheLimit)
+		m_Cache.clear();
+
+	m_Cache.emplace(Searched.Key, Searched.Nodes);
+}
+
+
+void PathGraph::ClearCache()
+{
+	m_Cache.clear();
+}
+
+
+void PathGraph::AddEntrances(int32_t x, int32_t y, int32_t Dx, int32_t Dy, int32_t Length, std::vector<std::vector<Edge>>& Edges, std::vector<int32_t>& NodeOfCell)
+{
+	// the cell on the other side of the border is one step across it, (Dy, Dx) from this side
+	auto NodeFor = [&](int32_t Cx, int32_t Cy)
+	{
+		const uint32_t Cell = uint32_t(Cy * m_Columns + Cx);
+
+		if (NodeOfCell[Cell] < 0)
+		{
+			NodeOfCell[Cell] = int32_t(m_Nodes.size());
+
+			m_Nodes.push_back(Node{ Cell, ClusterOf(Cell), 0, 0 });
+			Edges.emplace_back();
+		}
+
+		return uint32_t(NodeOfCell[Cell]);
+	};
+
+	auto AddTransition = [&](int32_t i)
+	{
+		const uint32_t Inside	= NodeFor(x + Dx * i, y + Dy * i);
+		const uint32_t Outside	= NodeFor(x + Dx * i + Dy, y + Dy * i + Dx);
+
+		Edges[Inside].push_back(Edge{ Outside, NavigationGrid::StepCost[0], 0, 0 });
+		Edges[Outside].push_back(Edge{ Inside, NavigationGrid::StepCost[0], 0, 0 });
+	};
+
+	int32_t Run = -1;
+
+	for (int32_t i = 0; i <= Length; i++)
+	{
+		const bool Open = i < Length && !Blocked(x + Dx * i, y + Dy * i) && !Blocked(x + Dx * i + Dy, y + Dy * i + Dx);
+
+		if (Open && Run < 0)
+			Run = i;
+
+		if (!Open && Run >= 0)
+		{
+			const int32_t Last = i - 1;
+
+			if (Last - Run + 1 > LongEntrance)
+			{
+				AddTransition(Run);
+				AddTransition(Last);
+			}
+			else
+			{
+				AddTransition((Run + Last) / 2);
+			}
+
+			Run = -1;
+		}
+	}
+}
+
+
+void PathGraph::LinkCluster(SearchSpace& Space, uint32_t Cluster, std::vector<std::vector<Edge>>& Edges)
+{
+	const Area Bounds = AreaOf(Cluster);
+
+	for (uint32_t i = m_ClusterFirst[Cluster]; i < m_ClusterFirst[Cluster + 1]; i++)
+	{
+		const uint32_t From = m_ClusterNodes[i];
+
+		SearchCells(Space, m_Nodes[From].Cell, NoCell, Bounds);
+
+		for (uint32_t j = m_ClusterFirst[Cluster]; j < m_ClusterFirst[Cluster + 1]; j++)
+		{
+			const uint32_t To	= m_ClusterNodes[j];
+			const uint32_t Cell	= m_Nodes[To].Cell;
+
+			if (To == From || Space.m_CellStamp[Cell] != Space.m_Stamp)
+				continue;
+
+			Space.m_Cells.clear();
+			AppendCells(Space, m_Nodes[From].Cell, Cell);
+
+			Edges[From].push_back(Edge{ To, Space.m_CellCost[Cell], uint32_t(m_EdgeCells.size()), uint32_t(Space.m_Cells.size()) });
+			m_EdgeCells.insert(m_EdgeCells.end(), Space.m_Cells.begin(), Space.m_Cells.end());
+		}
+	}
+}
+
+
+bool PathGraph::SearchCells(SearchSpace& Space, uint32_t Start, uint32_t Goal, const Area& Bounds) const
+{
+	Space.NextQuery();
+
+	auto& Cost		= Space.m_CellCost;
+	auto& Parent	= Space.m_CellParent;
+	auto& Stamp		= Space.m_CellStamp;
+	auto& Open		= Space.m_Open;
+
+	const uint32_t Query = Space.m_Stamp;
+
+	auto Estimate = [&](uint32_t Cell, uint32_t CostSoFar)
+	{
+		return Goal == NoCell ? CostSoFar : CostSoFar + Heuristic(Cell, Goal);
+	};
+
+	Cost[Start]		= 0;
+	Parent[Start]	= NoCell;
+	Stamp[Start]	= Query;
+
+	Open.clear();
+	Open.push_back({ Estimate(Start, 0), Start });
+
+	while (!Open.empty())
+	{
+		std::pop_heap(Open.begin(), Open.end(), std::greater<>());
+
+		const SearchSpace::Open Current = Open.back();
+		Open.pop_back();
+
+		// queued again cheaper since
+		if (Current.Estimate != Estimate(Current.Index, Cost[Current.Index]))
+			continue;
+
+		if (Current.Index == Goal)
+			return true;
+
+		const int32_t x = int32_t(Current.Index % uint32_t(m_Columns));
+		const int32_t y = int32_t(Current.Index / uint32_t(m_Columns));
+
+		for (int Step = 0; Step < 8; Step++)
+		{
+			const int32_t Nx = x + NavigationGrid::StepX[Step];
+			const int32_t Ny = y + NavigationGrid::StepY[Step];
+
+			if (Nx < Bounds.Left || Ny < Bounds.Top || Nx > Bounds.Right || Ny > Bounds.Bottom || !CanStep(x, y, Step))
+				continue;
+
+			const uint32_t Next		= uint32_t(Ny * m_Columns + Nx);
+			const uint32_t NextCost	= Cost[Current.Index] + NavigationGrid::StepCost[Step];
+
+			if (Stamp[Next] != Query || NextCost < Cost[Next])
+			{
+				Cost[Next]		= NextCost;
+				Parent[Next]	= Current.Index;
+				Stamp[Next]		= Query;
+
+				Open.push_back({ Estimate(Next, NextCost), Next });
+				std::push_heap(Open.begin(), Open.end(), std::greater<>());
+			}
+		}
+	}
+
+	return Goal == NoCell;
+}
+
+
+void PathGraph::AppendCells(SearchSpace& Space, uint32_t From, uint32_t To) const
+{
+	Space.m_Segment.clear();
+
+	for (uint32_t Cell = To; Cell != From; Cell = Space.m_CellParent[Cell])
+		Space.m_Segment.push_back(Cell);
+
+	Space.m_Cells.insert(Space.m_Cells.end(), Space.m_Segment.rbegin(), Space.m_Segment.rend());
+}
+
+
+bool PathGraph::SearchRoute(SearchSpace& Space, uint32_t Start, uint32_t Goal) const
+{
+	const uint32_t StartCluster	= ClusterOf(Start);
+	const uint32_t GoalCluster	= ClusterOf(Goal);
+	const uint32_t GoalNode		= uint32_t(m_Nodes.size());
+
+	// paths are the same both ways, the cost from the goal to a node is the cost back.
+	// Taken first, the start search below reuses the cell arrays
+	SearchCells(Space, Goal, NoCell, AreaOf(GoalCluster));
+
+	Space.m_GoalCost.clear();
+
+	for (uint32_t i = m_ClusterFirst[GoalCluster]; i < m_ClusterFirst[GoalCluster + 1]; i++)
+	{
+		const uint32_t Cell = m_Nodes[m_ClusterNodes[i]].Cell;
+
+		Space.m_GoalCost.push_back(Space.m_CellStamp[Cell] == Space.m_Stamp ? Space.m_CellCost[Cell] : Unreached);
+	}
+
+	SearchCells(Space, Start, NoCell, AreaOf(StartCluster));
+
+	const uint32_t StartQuery = Space.m_Stamp;
+
+	Space.NextQuery();
+
+	auto& Cost		= Space.m_NodeCost;
+	auto& Parent	= Space.m_NodeParent;
+	auto& Stamp		= Space.m_NodeStamp;
+	auto& Open		= Space.m_Open;
+
+	const uint32_t Query = Space.m_Stamp;
+
+	auto Relax = [&](uint32_t To, uint32_t From, uint32_t NewCost)
+	{
+		if (Stamp[To] == Query && NewCost >= Cost[To])
+			return;
+
+		Cost[To]	= NewCost;
+		Parent[To]	= From;
+		Stamp[To]	= Query;
+
+		Open.push_back({ NewCost + (To == GoalNode ? 0 : Heuristic(m_Nodes[To].Cell, Goal)), To });
+		std::push_heap(Open.begin(), Open.end(), std::greater<>());
+	};
+
+	Open.clear();
+
+	// the start connects to every node of its cluster it reaches
+	for (uint32_t i = m_ClusterFirst[StartCluster]; i < m_ClusterFirst[StartCluster + 1]; i++)
+	{
+		const uint32_t Cell = m_Nodes[m_ClusterNodes[i]].Cell;
+
+		if (Space.m_CellStamp[Cell] == StartQuery)
+			Relax(m_ClusterNodes[i], NoCell, Space.m_CellCost[Cell]);
+	}
+
+	bool Found = false;
+
+	while (!Open.empty())
+	{
+		std::pop_heap(Open.begin(), Open.end(), std::greater<>());
+
+		const SearchSpace::Open Current = Open.back();
+		Open.pop_back();
+
+		if (Current.Index == GoalNode)
+		{
+			Found = true;
+			break;
+		}
+
+		const Node& From = m_Nodes[Current.Index];
+
+		if (Current.Estimate != Cost[Current.Index] + Heuristic(From.Cell, Goal))
+			continue;
+
+		// nodes of the goal's cluster lead to the goal itself
+		if (From.Cluster == GoalCluster)
+		{
+			const uint32_t Index = uint32_t(std::find(m_ClusterNodes.begin() + m_ClusterFirst[GoalCluster], m_ClusterNodes.begin() + m_ClusterFirst[GoalCluster + 1], Current.Index) - (m_ClusterNodes.begin() + m_ClusterFirst[GoalCluster]));
+
+			if (Space.m_GoalCost[Index] != Unreached)
+				Relax(GoalNode, Current.Index, Cost[Current.Index] + Space.m_GoalCost[Index]);
+		}
+
+		for (uint32_t e = From.FirstEdge; e < From.FirstEdge + From.EdgeCount; e++)
+			Relax(m_Edges[e].To, Current.Index, Cost[Current.Index] + m_Edges[e].Cost);
+	}
+
+	if (!Found)
+		return false;
+
+	Space.m_Route.clear();
+
+	for (uint32_t Index = Parent[GoalNode]; Index != NoCell; Index = Parent[Index])
+		Space.m_Route.push_back(Index);
+
+	std::reverse(Space.m_Route.begin(), Space.m_Route.end());
+
+	return true;
+}
+
+
+bool PathGraph::RefineRoute(SearchSpace& Space, uint32_t Start, uint32_t Goal) const
+{
+	const auto& Route = Space.m_Route;
+
+	const uint32_t First	= m_Nodes[Route.front()].Cell;
+	const uint32_t Last		= m_Nodes[Route.back()].Cell;
+
+	Space.m_Cells.assign(1, Start);
+
+	if (!SearchCells(Space, Start, First, AreaOf(ClusterOf(Start))))
+		return false;
+
+	AppendCells(Space, Start, First);
+
+	// the stored paths between the nodes, the cheapest edge where there are two
+	for (size_t i = 0; i + 1 < Route.size(); i++)
+	{
+		const Node&	From	= m_Nodes[Route[i]];
+		const Edge*	Best	= nullptr;
+
+		for (uint32_t e = From.FirstEdge; e < From.FirstEdge + From.EdgeCount; e++)
+		{
+			if (m_Edges[e].To == Route[i + 1] && (!Best || m_Edges[e].Cost < Best->Cost))
+				Best = &m_Edges[e];
+		}
+
+		if (!Best)
+			return false;
+
+		if (Best->CellCount == 0)
+			Space.m_Cells.push_back(m_Nodes[Route[i + 1]].Cell);
+		else
+			Space.m_Cells.insert(Space.m_Cells.end(), m_EdgeCells.begin() + Best->FirstCell, m_EdgeCells.begin() + Best->FirstCell + Best->CellCount);
+	}
+
+	if (!SearchCells(Space, Last, Goal, AreaOf(ClusterOf(Goal))))
+		return false;
+
+	AppendCells(Space, Last, Goal);
+
+	return true;
+}
+
+
+int32_t PathGraph::CellOf(SimVector2 Position) const
+{
+	const Vector2 Local = (Vector2(Position) - m_Origin) / m_CellSize;
+
+	if (!(Local.x >= 0.0f && Local.y >= 0.0f && Local.x < float(m_Columns) && Local.y < float(m_Rows)))
+		return -1;
+
+	return static_cast<int32_t>(Local.y) * m_Columns + static_cast<int32_t>(Local.x);
+}
+
+
+bool PathGraph::Blocked(int32_t x, int32_t y) const
+{
+	return x < 0 || y < 0 || x >= m_Columns || y >= m_Rows || m_Blocked[size_t(y) * m_Columns + x];
+}
+
+
+bool PathGraph::CanStep(int32_t x, int32_t y, int Step) const
+{
+	const int32_t Nx = x + NavigationGrid::StepX[Step];
+	const int32_t Ny = y + NavigationGrid::StepY[Step];
+
+	return !Blocked(Nx, Ny) && (Step < 4 || (!Blocked(Nx, y) && !Blocked(x, Ny)));
+}
+
+
+uint32_t PathGraph::ClusterOf(uint32_t Cell) const
+{
+	const int32_t x = int32_t(Cell % uint32_t(m_Columns));
+	const int32_t y = int32_t(Cell / uint32_t(m_Columns));
+
+	return uint32_t((y / ClusterSize) * m_ClustersX + x / ClusterSize);
+}
+
+
+PathGraph::Area PathGraph::AreaOf(uint32_t Cluster) const
+{
+	const int32_t Left	= int32_t(Cluster % uint32_t(m_ClustersX)) * ClusterSize;
+	const int32_t Top	= int32_t(Cluster / uint32_t(m_ClustersX)) * ClusterSize;
+
+	return Area{ Left, Top, std::min(Left + ClusterSize, m_Columns) - 1, std::min(Top + ClusterSize, m_Rows) - 1 };
+}
+
+
+uint32_t PathGraph::Heuristic(uint32_t From, uint32_t To) const
+{
+	// octile distance in step costs, 2 per straight and 3 per diagonal step
+	const int32_t Dx = std::abs(int32_t(From % uint32_t(m_Columns)) - int32_t(To % uint32_t(m_Columns)));
+	const int32_t Dy = std::abs(int32_t(From / uint32_t(m_Columns)) - int32_t(To / uint32_t(m_Columns)));
+
+	return uint32_t(2 * std::max(Dx, Dy) + std::min(Dx, Dy));
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "../Memory/PoolAllocator.hpp"
+#include "../Simulation.hpp"
+
+#include "NavigationGrid.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// hierarchical A* (HPA*) over a copy of the navigation grid.
+// The grid is cut into ClusterSize square clusters. Every run of open
+// cells along a border between two clusters gets an entrance, a node on
+// each side linked by one step. Nodes of the same cluster are linked by
+// the cheapest path between them inside the cluster, found once at build
+// time and stored. A query only searches the start and goal clusters cell
+// by cell, everything in between is an A* over the few nodes, then the
+// stored paths are stitched together. Routes between two clusters are
+// cached and reused by every query between the same pair of clusters, the
+// cache goes with the graph when it's rebuilt.
+//
+// Queries are const and safe from any number of threads, each with its
+// own SearchSpace. They only read the cache. A route a query had to search
+// for comes back to the caller, who hands it to Learn on one thread once
+// the queries are done, so what a query finds never depends on which
+// other query happened to run first.
+
+class PathGraph
+{
+
+public:
+
+	static constexpr int32_t	ClusterSize	= 8;
+	static constexpr size_t		CacheLimit	= 4096;	// routes, the cache starts over past this
+
+
+public:
+
+	// a route a query searched for because the cache didn't have one
+	struct Route
+	{
+		uint64_t				Key			= 0;
+		bool					Searched	= false;
+		std::vector<uint32_t>	Nodes;
+	};
+
+	// what one thread searches with. Allocated from the page arena, sized
+	// to the graph on first use and reused by every query after, nothing
+	// is cleared between queries (entries are stamped with the query)
+	class SearchSpace
+	{
+
+	public:
+
+		SearchSpace() = default;
+
+
+	private:
+
+		friend class PathGraph;
+
+		struct Open
+		{
+			uint32_t	Estimate;	// cost so far plus the heuristic
+			uint32_t	Index;
+
+			bool operator > (const Open& rhs) const { return Estimate > rhs.Estimate; }
+		};
+
+		template<typename Type>
+		using PoolVector = std::vector<Type, Memory::PoolAllocator<Type>>;
+
+		void Fit(size_t Cells, size_t Nodes);
+		void NextQuery();
+
+		PoolVector<uint32_t>	m_CellCost;
+		PoolVector<uint32_t>	m_CellParent;
+		PoolVector<uint32_t>	m_CellStamp;
+
+		// every node, plus the goal as one more
+		PoolVector<uint32_t>	m_NodeCost;
+		PoolVector<uint32_t>	m_NodeParent;
+		PoolVector<uint32_t>	m_NodeStamp;
+
+		PoolVector<Open>		m_Open;
+		PoolVector<uint32_t>	m_Route;
+		PoolVector<uint32_t>	m_Cells;
+		PoolVector<uint32_t>	m_Segment;
+
+		// cost from the goal cell to every node of its cluster it reaches
+		PoolVector<uint32_t>	m_GoalCost;
+
+		uint32_t				m_Stamp = 0;
+
+	};
+
+
+public:
+
+	PathGraph();
+	~PathGraph() = default;
+
+	PathGraph(const PathGraph&) = delete;
+	PathGraph& operator = (const PathGraph&) = delete;
+
+
+public:
+
+	// copies the grid, finds the entrances and the paths between them
+	void Build(const NavigationGrid& Grid);
+
+	// waypoints from Start to Goal, cell centres where the path turns and
+	// Goal itself last. False when either is blocked, off the grid or the
+	// goal can't be reached. Searched is set when the route between the
+	// two clusters wasn't cached
+	bool FindPath(SearchSpace& Space, SimVector2 Start, SimVector2 Goal, std::vector<SimVector2>& Waypoints, Route& Searched) const;
+
+	// caches a route FindPath searched for, unless one is cached for the
+	// same clusters already. Not while queries run
+	void Learn(const Route& Searched);
+
+	void ClearCache();
+
+	size_t		Nodes()			const { return m_Nodes.size(); }
+	uint64_t	CacheHits()		const { return m_CacheHits.load(std::memory_order_relaxed); }
+	uint64_t	CacheMisses()	const { return m_CacheMisses.load(std::memory_order_relaxed); }
+
+
+private:
+
+	struct Node
+	{
+		uint32_t	Cell;
+		uint32_t	Cluster;
+		uint32_t	FirstEdge;
+		uint32_t	EdgeCount;
+	};
+
+	struct Edge
+	{
+		uint32_t	To;
+		uint32_t	Cost;
+		uint32_t	FirstCell;	// stored path, empty for a step across a border
+		uint32_t	CellCount;
+	};
+
+	struct Area
+	{
+		int32_t		Left;
+		int32_t		Top;
+		int32_t		Right;	// inclusive
+		int32_t		Bottom;
+	};
+
+
+private:
+
+	int32_t		CellOf(SimVector2 Position) const;
+	bool		Blocked(int32_t x, int32_t y) const;
+	bool		CanStep(int32_t x, int32_t y, int Step) const;
+	uint32_t	ClusterOf(uint32_t Cell) const;
+	Area		AreaOf(uint32_t Cluster) const;
+	uint32_t	Heuristic(uint32_t From, uint32_t To) const;
+
+	void AddEntrances(int32_t x, int32_t y, int32_t Dx, int32_t Dy, int32_t Length, std::vector<std::vector<Edge>>& Edges, std::vector<int32_t>& NodeOfCell);
+	void LinkCluster(SearchSpace& Space, uint32_t Cluster, std::vector<std::vector<Edge>>& Edges);
+
+	// A* cell by cell inside Bounds from Start, to Goal or every cell when Goal is NoCell
+	bool SearchCells(SearchSpace& Space, uint32_t Start, uint32_t Goal, const Area& Bounds) const;
+
+	// appends the cells after From on the way to To, as SearchCells left them
+	void AppendCells(SearchSpace& Space, uint32_t From, uint32_t To) const;
+
+	bool SearchRoute(SearchSpace& Space, uint32_t Start, uint32_t Goal) const;
+	bool RefineRoute(SearchSpace& Space, uint32_t Start, uint32_t Goal) const;
+
+
+private:
+
+	Vector2					m_Origin;
+	float					m_CellSize;
+	int32_t					m_Columns;
+	int32_t					m_Rows;
+	std::vector<uint8_t>	m_Blocked;
+
+	int32_t					m_ClustersX;
+	int32_t					m_ClustersY;
+
+	std::vector<Node>		m_Nodes;
+	std::vector<Edge>		m_Edges;
+	std::vector<uint32_t>	m_EdgeCells;
+
+	// nodes of every cluster, m_ClusterNodes[m_ClusterFirst[c]] onwards
+	std::vector<uint32_t>	m_ClusterFirst;
+	std::vector<uint32_t>	m_ClusterNodes;
+
+	// node routes by start and goal cluster, read only while queries run
+	std::unordered_map<uint64_t, std::vector<uint32_t>>	m_Cache;
+	mutable std::atomic<uint64_t>						m_CacheHits;
+	mutable std::atomic<uint64_t>						m_CacheMisses;
+
+};
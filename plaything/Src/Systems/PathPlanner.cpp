@@ -0,0 +1,205 @@
+#include "PathPlanner.hpp"
+
+#include "../Components/TransformComponent.hpp"
+
+PathPlanner::PathPlanner()
+	: m_GraphVersion(0)
+	, m_GraphBuilt(false)
+	, m_NextTicket(0)
+	, m_Batch(QueryBudget)
+	, m_BatchSize(0)
+	, m_Claimed(0)
+	, m_Generation(0)
+	, m_Busy(0)
+	, m_Quit(false)
+{
+
+}
+
+
+PathPlanner::~PathPlanner()
+{
+	Stop();
+}
+
+
+void PathPlanner::Start(uint32_t WorkerCount)
+{
+	if (!m_Workers.empty())
+		return;
+
+	m_Quit = false;
+
+	for (uint32_t i = 0; i < WorkerCount; ++i)
+	{
+		m_Workers.emplace_back(&PathPlanner::WorkerLoop, this, m_Generation);
+	}
+}
+
+
+void PathPlanner::Stop()
+{
+	Wait();
+
+	{
+		std::lock_guard Lock(m_Mutex);
+		m_Quit = true;
+	}
+
+	m_WakeCondition.notify_all();
+
+	for (auto& Worker : m_Workers)
+	{
+		Worker.join();
+	}
+
+	m_Workers.clear();
+
+	m_BatchSize = 0;
+	m_Pending.clear();
+}
+
+
+void PathPlanner::Request(Registry& Scene, entt::entity Entity, SimVector2 Goal)
+{
+	const uint32_t Ticket = ++m_NextTicket;
+
+	Scene.emplace_or_replace<PathComponent>(Entity, Goal, Ticket);
+	m_Pending.push_back(Queued{ Entity, Ticket });
+}
+
+
+void PathPlanner::Update(Registry& Scene, const NavigationGrid& Grid)
+{
+	Wait();
+
+	// answers to requests that were replaced since, or whose entity is gone, are dropped.
+	// Their routes are still cached, in batch order, whatever order the workers ran in
+	for (uint32_t i = 0; i < m_BatchSize; i++)
+	{
+		Query& Each = m_Batch[i];
+
+		m_Graph.Learn(Each.Searched);
+
+		PathComponent* Path = Scene.valid(Each.Entity) ? Scene.try_get<PathComponent>(Each.Entity) : nullptr;
+
+		if (!Path || Path->m_Ticket != Each.Ticket)
+			continue;
+
+		// swapped rather than copied, the query keeps the old buffer for its next search
+		Path->m_Waypoints.swap(Each.Waypoints);
+		Path->m_Next	= 0;
+		Path->m_State	= Each.Found ? PathComponent::State::Ready : PathComponent::State::Failed;
+	}
+
+	m_BatchSize = 0;
+
+	for (auto Entity : Scene.view<PathComponent>())
+	{
+		if (Scene.get<PathComponent>(Entity).Finished())
+			Scene.remove<PathComponent>(Entity);
+	}
+
+	if (!m_GraphBuilt || Grid.Version() != m_GraphVersion)
+	{
+		m_Graph.Build(Grid);
+
+		m_GraphVersion	= Grid.Version();
+		m_GraphBuilt	= true;
+	}
+
+	while (m_BatchSize < QueryBudget && !m_Pending.empty())
+	{
+		const Queued Next = m_Pending.front();
+		m_Pending.pop_front();
+
+		PathComponent*				Path		= Scene.valid(Next.Entity) ? Scene.try_get<PathComponent>(Next.Entity) : nullptr;
+		const TransformComponent*	Transform	= Path ? Scene.try_get<TransformComponent>(Next.Entity) : nullptr;
+
+		if (!Path || Path->m_Ticket != Next.Ticket || Path->m_State != PathComponent::State::Pending)
+			continue;
+
+		if (!Transform)
+		{
+			Path->m_State = PathComponent::State::Failed;
+			continue;
+		}
+
+		Query& Each = m_Batch[m_BatchSize++];
+
+		Each.Entity	= Next.Entity;
+		Each.Ticket	= Next.Ticket;
+		Each.Start	= Transform->m_Position;
+		Each.Goal	= Path->m_Goal;
+		Each.Found	= false;
+	}
+
+	if (m_BatchSize == 0)
+		return;
+
+	m_Claimed.store(0, std::memory_order_relaxed);
+
+	if (m_Workers.empty())
+	{
+		RunBatch(m_Space);
+		return;
+	}
+
+	{
+		std::lock_guard Lock(m_Mutex);
+
+		m_Busy = static_cast<uint32_t>(m_Workers.size());
+		++m_Generation;
+	}
+
+	m_WakeCondition.notify_all();
+}
+
+
+void PathPlanner::Wait()
+{
+	std::unique_lock Lock(m_Mutex);
+	m_DoneCondition.wait(Lock, [this]() { return m_Busy == 0; });
+}
+
+
+void PathPlanner::RunBatch(PathGraph::SearchSpace& Space)
+{
+	for (uint32_t Index = m_Claimed.fetch_add(1, std::memory_order_relaxed);
+		 Index < m_BatchSize;
+		 Index = m_Claimed.fetch_add(1, std::memory_order_relaxed))
+	{
+		Query& Each = m_Batch[Index];
+
+		Each.Found = m_Graph.FindPath(Space, Each.Start, Each.Goal, Each.Waypoints, Each.Searched);
+	}
+}
+
+
+void PathPlanner::WorkerLoop(uint64_t SeenGeneration)
+{
+	// every worker searches with its own scratch, kept for the thread's lifetime
+	PathGraph::SearchSpace Space;
+
+	while (true)
+	{
+		{
+			std::unique_lock Lock(m_Mutex);
+			m_WakeCondition.wait(Lock, [&]() { return m_Quit || m_Generation != SeenGeneration; });
+
+			if (m_Quit)
+				return;
+
+			SeenGeneration = m_Generation;
+		}
+
+		RunBatch(Space);
+
+		{
+			std::lock_guard Lock(m_Mutex);
+			--m_Busy;
+		}
+
+		m_DoneCondition.notify_one();
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../Components/PathComponent.hpp"
+#include "../Registry.hpp"
+#include "../Simulation.hpp"
+
+#include "NavigationGrid.hpp"
+#include "PathGraph.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// answers path requests on worker threads, off the frame.
+// Requests queue up on the main thread. Every update dispatches at most
+// QueryBudget of them as one batch, workers search it while the frame goes
+// on and the next update waits for the batch and hands the waypoints to the
+// PathComponents. Answers always land one update after dispatch, however
+// fast the workers were. Workers only read the route cache as it stood at
+// dispatch, the routes they had to search are cached by the next update in
+// batch order. Together that keeps the simulation deterministic whatever
+// the thread timing. The graph is rebuilt between batches whenever the
+// navigation grid changed.
+
+class PathPlanner
+{
+
+public:
+
+	static constexpr uint32_t QueryBudget = 64;	// searches dispatched per update
+
+
+public:
+
+	PathPlanner();
+	~PathPlanner();
+
+	PathPlanner(const PathPlanner&) = delete;
+	PathPlanner& operator = (const PathPlanner&) = delete;
+
+
+public:
+
+	// without workers the searches run inline in Update
+	void Start(uint32_t WorkerCount);
+
+	// waits for the batch in flight and drops it
+	void Stop();
+
+	// gives Entity a PathComponent towards Goal, replacing any path it had
+	void Request(Registry& Scene, entt::entity Entity, SimVector2 Goal);
+
+	// delivers the last batch, removes finished paths and dispatches the next batch
+	void Update(Registry& Scene, const NavigationGrid& Grid);
+
+	const PathGraph&	Graph()		const { return m_Graph; }
+	size_t				Pending()	const { return m_Pending.size(); }
+
+
+private:
+
+	struct Query
+	{
+		entt::entity			Entity;
+		uint32_t				Ticket;
+		SimVector2				Start;
+		SimVector2				Goal;
+		bool					Found;
+		std::vector<SimVector2>	Waypoints;
+		PathGraph::Route		Searched;
+	};
+
+	struct Queued
+	{
+		entt::entity	Entity;
+		uint32_t		Ticket;
+	};
+
+
+private:
+
+	void Wait();
+	void RunBatch(PathGraph::SearchSpace& Space);
+	void WorkerLoop(uint64_t SeenGeneration);
+
+
+private:
+
+	PathGraph				m_Graph;
+	uint32_t				m_GraphVersion;
+	bool					m_GraphBuilt;
+
+	// main thread only
+	std::deque<Queued>		m_Pending;
+	uint32_t				m_NextTicket;
+	PathGraph::SearchSpace	m_Space;
+
+	// the batch in flight, read only for the main thread until it's done
+	std::vector<Query>		m_Batch;
+	uint32_t				m_BatchSize;
+	std::atomic<uint32_t>	m_Claimed;
+
+	std::mutex					m_Mutex;
+	std::condition_variable		m_WakeCondition;
+	std::condition_variable		m_DoneCondition;
+
+	std::vector<std::thread>	m_Workers;
+	uint64_t					m_Generation;
+	uint32_t					m_Busy;
+	bool						m_Quit;
+
+};
@@ -0,0 +1,56 @@
+#include "RenderPrepSystem.hpp"
+
+#include "../Components/ColorComponent.hpp"
+#include "../Components/HierarchyComponent.hpp"
+#include "../Components/QuadComponent.hpp"
+#include "../Components/Tags.hpp"
+#include "../Components/TransformComponent.hpp"
+
+#include "../Renderer/RenderCommand.hpp"
+
+#include "Groups.hpp"
+
+namespace Systems
+{
+	void RenderPrep(Registry& Scene, RenderCommandList& Commands, bool DrawStatic)
+	{
+		// draw static
+		if (DrawStatic)
+		{
+			auto StaticView = Scene.view<TransformComponent, QuadComponent, ColorComponent, Tags::Static>();
+			for (auto [Entity, Transform, Quad, Color] : StaticView.each())
+			{
+				Commands.Color(Color.m_Color.r, Color.m_Color.g, Color.m_Color.b, Color.m_Color.a);
+				Commands.Quad(Quad.World(Transform), QuadFill | QuadOutline, entt::to_integral(Entity));
+			}
+		}
+
+
+		// draw enemy
+		Commands.Color(255, 0, 0, 255);
+
+		for (auto [Entity, Transform, Quad, Collider] : Groups::Enemies(Scene).each())
+		{
+			Commands.Quad(Quad.World(Transform), QuadFill | QuadOutline, entt::to_integral(Entity));
+		}
+
+
+		// draw player
+		Commands.Color(0, 255, 255, 255);
+
+		auto PlayerView = Scene.view<TransformComponent, QuadComponent, Tags::Player>();
+		for (auto [Entity, Transform, Quad] : PlayerView.each())
+		{
+			Commands.Quad(Quad.World(Transform), QuadFill | QuadOutline, entt::to_integral(Entity));
+		}
+
+
+		// draw attachments, on top of what they're attached to
+		auto AttachmentView = Scene.view<TransformComponent, QuadComponent, ColorComponent, HierarchyComponent>();
+		for (auto [Entity, Transform, Quad, Color, Node] : AttachmentView.each())
+		{
+			Commands.Color(Color.m_Color.r, Color.m_Color.g, Color.m_Color.b, Color.m_Color.a);
+			Commands.Quad(Quad.World(Transform), QuadFill | QuadOutline, entt::to_integral(Entity));
+		}
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "../Registry.hpp"
+
+class RenderCommandList;
+
+namespace Systems
+{
+	// walks the scene and records what has to be drawn this frame,
+	// nothing in here talks to SDL. Static geometry is only recorded when
+	// it isn't already composited from the static layer.
+	void RenderPrep(Registry& Scene, RenderCommandList& Commands, bool DrawStatic);
+}
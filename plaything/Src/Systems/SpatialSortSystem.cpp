@@ -0,0 +1,39 @@
+#include "SpatialSortSystem.hpp"
+
+#include "Groups.hpp"
+
+#include "../Morton.hpp"
+
+namespace Systems
+{
+	void SortEnemiesSpatially(Registry& Scene, bool Incremental, std::vector<uint32_t>& Keys)
+	{
+		using Traits = entt::entt_traits<entt::entity>;
+
+		auto Enemies = Groups::Enemies(Scene);
+
+		// keys up front, indexed by entity, so comparing doesn't go through
+		// the sparse sets and recompute the code every time
+		for (auto [Entity, Transform, Quad, Collider] : Enemies.each())
+		{
+			const size_t Index = Traits::to_entity(Entity);
+
+			if (Index >= Keys.size())
+				Keys.resize(Index + 1);
+
+			Keys[Index] = Morton::Encode(Vector2(Transform.m_Position), SpatialSortCell);
+		}
+
+		auto Compare = [&Keys](const entt::entity Lhs, const entt::entity Rhs)
+		{
+			return Keys[Traits::to_entity(Lhs)] < Keys[Traits::to_entity(Rhs)];
+		};
+
+		// owned storages can't go through registry.sort, the group sorts
+		// its own range and permutes every storage it owns along with it
+		if (Incremental)
+			Enemies.sort(Compare, entt::insertion_sort{});
+		else
+			Enemies.sort(Compare);
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../Registry.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Systems
+{
+	// cell size the Morton keys are computed on, about the size of an enemy
+	// quad so the ones sharing a cell are the ones that can touch
+	constexpr float SpatialSortCell = 32.0f;
+
+	// reorders the enemy group by the Morton key of each transform so
+	// neighbours on screen are neighbours in every owned storage.
+	// Incremental sorts with insertion sort, close to linear when only a
+	// few entities crossed a cell since the last sort; anything else is a
+	// full sort. Keys is scratch indexed by entity, kept by the caller
+	// between sorts so they don't allocate
+	void SortEnemiesSpatially(Registry& Scene, bool Incremental, std::vector<uint32_t>& Keys);
+}
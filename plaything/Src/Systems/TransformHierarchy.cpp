@@ -0,0 +1,380 @@
+#include "TransformHierarchy.hpp"
+
+#include "../Components/HierarchyComponent.hpp"
+#include "../Components/TransformComponent.hpp"
+
+namespace
+{
+	using Traits = entt::entt_traits<entt::entity>;
+
+	constexpr size_t	PageSize	= entt::component_traits<HierarchyComponent>::page_size;
+	constexpr uint32_t	Root		= HierarchyComponent::Root;
+	constexpr uint32_t	Unranked	= ~0u;
+
+	template<typename Storage>
+	HierarchyComponent& NodeAt(Storage& Nodes, size_t Slot)
+	{
+		return Nodes.raw()[Slot / PageSize][Slot % PageSize];
+	}
+}
+
+TransformHierarchy::TransformHierarchy()
+	: m_OrderDirty(true)
+{
+
+}
+
+
+void TransformHierarchy::Connect(Registry& Scene)
+{
+	Scene.on_construct<HierarchyComponent>().connect<&TransformHierarchy::OnConstruct>(this);
+	Scene.on_update<HierarchyComponent>().connect<&TransformHierarchy::OnUpdate>(this);
+	Scene.on_destroy<HierarchyComponent>().connect<&TransformHierarchy::OnDestroy>(this);
+}
+
+
+void TransformHierarchy::Disconnect(Registry& Scene)
+{
+	Scene.on_construct<HierarchyComponent>().disconnect(this);
+	Scene.on_update<HierarchyComponent>().disconnect(this);
+	Scene.on_destroy<HierarchyComponent>().disconnect(this);
+}
+
+
+bool TransformHierarchy::Attach(Registry& Scene, entt::entity Child, entt::entity Parent, Vector2 Local)
+{
+	for (entt::entity Ancestor = Parent; Scene.valid(Ancestor); )
+	{
+		if (Ancestor == Child)
+			return false;
+
+		const HierarchyComponent* Node = Scene.try_get<HierarchyComponent>(Ancestor);
+		Ancestor = Node ? Node->m_Parent : entt::null;
+	}
+
+	const HierarchyComponent* Node = Scene.try_get<HierarchyComponent>(Child);
+
+	// same parent, only the offset changes
+	if (Node && Node->m_Parent == Parent)
+	{
+		SetLocal(Scene, Child, Local);
+		return true;
+	}
+
+	Scene.emplace_or_replace<HierarchyComponent>(Child, Parent, Local);
+
+	return true;
+}
+
+
+void TransformHierarchy::Detach(Registry& Scene, entt::entity Child)
+{
+	// keeps the transform where the parent last put it
+	Scene.remove<HierarchyComponent>(Child);
+}
+
+
+void TransformHierarchy::SetLocal(Registry& Scene, entt::entity Child, Vector2 Local)
+{
+	HierarchyComponent& Node = Scene.get<HierarchyComponent>(Child);
+
+	Node.m_Local	= SimVector2(Local);
+	Node.m_Dirty	= true;
+
+	if (m_OrderDirty)
+		return;
+
+	// the subtrees it's in can't be skipped on the next update
+	auto& Nodes = Scene.storage<HierarchyComponent>();
+
+	for (uint32_t Up = Node.m_ParentIndex; Up != Root; )
+	{
+		HierarchyComponent& Ancestor = NodeAt(Nodes, Up);
+
+		Ancestor.m_DirtyBelow	= true;
+		Up						= Ancestor.m_ParentIndex;
+	}
+}
+
+
+void TransformHierarchy::Update(Registry& Scene)
+{
+	if (m_OrderDirty)
+		Rebuild(Scene);
+
+	auto& Nodes			= Scene.storage<HierarchyComponent>();
+	auto& Transforms	= Scene.storage<TransformComponent>();
+
+	HierarchyComponent* const* Pages = Nodes.raw();
+
+	// the packed array runs parents first, walk it front to back
+	for (size_t i = 0; i < Nodes.size(); )
+	{
+		HierarchyComponent& Node = Pages[i / PageSize][i % PageSize];
+
+		SimVector2	ParentWorld;
+		bool		ParentMoved;
+
+		if (Node.m_ParentIndex == Root)
+		{
+			// the root itself is the only lookup left
+			const TransformComponent* Parent = Transforms.contains(Node.m_Parent) ? &Transforms.get(Node.m_Parent) : nullptr;
+
+			if (!Parent)
+			{
+				m_Orphans.push_back(Nodes.data()[i++]);
+				continue;
+			}
+
+			// the root was attached to something since, its children belong behind it
+			if (Nodes.contains(Node.m_Parent))
+				m_OrderDirty = true;
+
+			ParentWorld	= Parent->m_Position;
+			ParentMoved	= Parent->m_Dirty;
+		}
+		else
+		{
+			const HierarchyComponent& Parent = Pages[Node.m_ParentIndex / PageSize][Node.m_ParentIndex % PageSize];
+
+			ParentWorld	= Parent.m_World;
+			ParentMoved	= Parent.m_Moved;
+		}
+
+		Node.m_Moved = ParentMoved || Node.m_Dirty;
+
+		if (!Node.m_Moved)
+		{
+			// nothing above moved and nothing below changed, the whole subtree stays put
+			i += Node.m_Packed && !Node.m_DirtyBelow ? Node.m_Subtree : 1;
+
+			Node.m_DirtyBelow = false;
+			continue;
+		}
+
+		Node.m_World		= ParentWorld + Node.m_Local;
+		Node.m_Dirty		= false;
+		Node.m_DirtyBelow	= false;
+
+		TransformComponent& Transform = Transforms.get(Nodes.data()[i++]);
+
+		Transform.m_Position	= Node.m_World;
+		Transform.m_Dirty		= true;
+	}
+
+	// the children of these go next tick, once their parent's slot is gone
+	if (!m_Orphans.empty())
+	{
+		Scene.destroy(m_Orphans.begin(), m_Orphans.end());
+		m_Orphans.clear();
+	}
+}
+
+
+void TransformHierarchy::Rebuild(Registry& Scene)
+{
+	auto& Nodes = Scene.storage<HierarchyComponent>();
+
+	// a destroyed parent takes the whole subtree with it, level by level.
+	// A cycle has no root to hang from and goes all at once
+	do
+	{
+		Scene.destroy(m_Orphans.begin(), m_Orphans.end());
+		m_Orphans.clear();
+
+		const size_t Count = Nodes.size();
+
+		// children by their parent's slot, counted and then filled in
+		m_ChildStart.assign(Count + 1, 0);
+
+		for (size_t i = 0; i < Count; i++)
+		{
+			HierarchyComponent& Node = NodeAt(Nodes, i);
+
+			Node.m_ParentIndex = Nodes.contains(Node.m_Parent) ? uint32_t(Nodes.index(Node.m_Parent)) : Root;
+
+			if (Node.m_ParentIndex != Root)
+				m_ChildStart[Node.m_ParentIndex + 1]++;
+		}
+
+		for (size_t i = 0; i < Count; i++)
+			m_ChildStart[i + 1] += m_ChildStart[i];
+
+		m_Children.resize(m_ChildStart[Count]);
+		m_Stack.assign(m_ChildStart.begin(), m_ChildStart.end() - 1);
+
+		for (size_t i = 0; i < Count; i++)
+		{
+			const uint32_t Parent = NodeAt(Nodes, i).m_ParentIndex;
+
+			if (Parent != Root)
+				m_Children[m_Stack[Parent]++] = uint32_t(i);
+		}
+
+		for (size_t i = 0; i < Count; i++)
+		{
+			const size_t Index = Traits::to_entity(Nodes.data()[i]);
+
+			if (Index >= m_Rank.size())
+				m_Rank.resize(Index + 1);
+
+			m_Rank[Index] = Unranked;
+		}
+
+		// depth first from every child of a root, in storage order
+		m_Stack.clear();
+
+		uint32_t Next = 0;
+
+		for (uint32_t Top = 0; Top < Count; Top++)
+		{
+			if (NodeAt(Nodes, Top).m_ParentIndex != Root)
+				continue;
+
+			m_Stack.push_back(Top);
+
+			while (!m_Stack.empty())
+			{
+				const uint32_t Slot = m_Stack.back();
+				m_Stack.pop_back();
+
+				m_Rank[Traits::to_entity(Nodes.data()[Slot])] = Next++;
+
+				// last child pushed first so the children come out in storage order
+				for (uint32_t Child = m_ChildStart[Slot + 1]; Child > m_ChildStart[Slot]; Child--)
+					m_Stack.push_back(m_Children[Child - 1]);
+			}
+		}
+
+		for (auto [Entity, Node] : Nodes.each())
+		{
+			if (!Scene.valid(Node.m_Parent) || m_Rank[Traits::to_entity(Entity)] == Unranked)
+				m_Orphans.push_back(Entity);
+		}
+	}
+	while (!m_Orphans.empty());
+
+	// highest rank compares first so the packed array ends up in rank order
+	Scene.sort<HierarchyComponent>([this](const entt::entity Lhs, const entt::entity Rhs)
+	{
+		return m_Rank[Traits::to_entity(Lhs)] > m_Rank[Traits::to_entity(Rhs)];
+	});
+
+	// every node's slot is its rank now
+	const size_t Count = Nodes.size();
+
+	for (size_t i = 0; i < Count; i++)
+	{
+		HierarchyComponent& Node = NodeAt(Nodes, i);
+
+		Node.m_ParentIndex	= Node.m_ParentIndex == Root ? Root : m_Rank[Traits::to_entity(Node.m_Parent)];
+		Node.m_Subtree		= 1;
+		Node.m_Dirty		= true;
+		Node.m_DirtyBelow	= false;
+		Node.m_Packed		= true;
+	}
+
+	// children sit behind their parents, summing back to front sizes every subtree
+	for (size_t i = Count; i-- > 0; )
+	{
+		const HierarchyComponent& Node = NodeAt(Nodes, i);
+
+		if (Node.m_ParentIndex != Root)
+			NodeAt(Nodes, Node.m_ParentIndex).m_Subtree += Node.m_Subtree;
+	}
+
+	m_OrderDirty = false;
+}
+
+
+void TransformHierarchy::OnConstruct(Registry& Scene, entt::entity Entity)
+{
+	if (m_OrderDirty)
+		return;
+
+	auto& Nodes = Scene.storage<HierarchyComponent>();
+
+	const uint32_t		Slot = uint32_t(Nodes.index(Entity));
+	HierarchyComponent&	Node = NodeAt(Nodes, Slot);
+
+	Node.m_ParentIndex	= Nodes.contains(Node.m_Parent) ? uint32_t(Nodes.index(Node.m_Parent)) : Root;
+	Node.m_Subtree		= 1;
+	Node.m_Dirty		= true;
+	Node.m_DirtyBelow	= false;
+	Node.m_Packed		= true;
+
+	// new nodes land at the back, behind a parent that was there first
+	if (Node.m_ParentIndex != Root && Node.m_ParentIndex >= Slot)
+	{
+		m_OrderDirty = true;
+		return;
+	}
+
+	// every ancestor grows by one, and stays packed if its subtree ended where the node landed
+	for (uint32_t Up = Node.m_ParentIndex; Up != Root; )
+	{
+		HierarchyComponent& Ancestor = NodeAt(Nodes, Up);
+
+		Ancestor.m_Packed		= Ancestor.m_Packed && Up + Ancestor.m_Subtree == Slot;
+		Ancestor.m_Subtree		+= 1;
+		Ancestor.m_DirtyBelow	= true;
+		Up						= Ancestor.m_ParentIndex;
+	}
+}
+
+
+void TransformHierarchy::OnUpdate(Registry& Scene, entt::entity Entity)
+{
+	// a replaced node may hang from another parent now, reparenting sorts
+	m_OrderDirty = true;
+}
+
+
+void TransformHierarchy::OnDestroy(Registry& Scene, entt::entity Entity)
+{
+	if (m_OrderDirty)
+		return;
+
+	auto& Nodes = Scene.storage<HierarchyComponent>();
+
+	const uint32_t				Slot = uint32_t(Nodes.index(Entity));
+	const uint32_t				Last = uint32_t(Nodes.size() - 1);
+	const HierarchyComponent&	Node = NodeAt(Nodes, Slot);
+
+	// its children lose their parent's slot, the sort takes them out
+	if (Node.m_Subtree > 1)
+	{
+		m_OrderDirty = true;
+		return;
+	}
+
+	for (uint32_t Up = Node.m_ParentIndex; Up != Root; )
+	{
+		HierarchyComponent& Ancestor = NodeAt(Nodes, Up);
+
+		Ancestor.m_Packed	= Ancestor.m_Packed && Slot == Last;
+		Ancestor.m_Subtree	-= 1;
+		Up					= Ancestor.m_ParentIndex;
+	}
+
+	if (Slot == Last)
+		return;
+
+	// the storage moves the last node into the freed slot. Parents go first,
+	// so the last node is nobody's parent and only its own slot changes
+	const HierarchyComponent& Moved = NodeAt(Nodes, Last);
+
+	if (Moved.m_ParentIndex != Root && Moved.m_ParentIndex > Slot)
+	{
+		m_OrderDirty = true;
+		return;
+	}
+
+	for (uint32_t Up = Moved.m_ParentIndex; Up != Root; )
+	{
+		HierarchyComponent& Ancestor = NodeAt(Nodes, Up);
+
+		Ancestor.m_Packed	= false;
+		Up					= Ancestor.m_ParentIndex;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../Registry.hpp"
+#include "../Vector2.hpp"
+
+#include <vector>
+
+// parent / child transforms.
+// The hierarchy storage keeps parents in front of their children, and every
+// child knows the slot of its parent, so world positions are computed in one
+// pass front to back without recursion and without looking parents up. A
+// child is only recomputed when its own offset or its parent moved.
+//
+// A sort lays the storage out depth first, so every subtree sits right
+// behind its top node and a subtree where nothing moved or changed is
+// skipped whole. Only reparenting sorts. A new child is appended at the
+// back, and a leaf goes by swapping the last node into its slot. Each of
+// these only touches the node's ancestors, and the subtrees they break up
+// are walked node by node until the next sort. Children die with their
+// parent.
+
+class TransformHierarchy
+{
+
+public:
+
+	TransformHierarchy();
+	~TransformHierarchy() = default;
+
+
+public:
+
+	void Connect(Registry& Scene);
+	void Disconnect(Registry& Scene);
+
+	// false if it would make Child its own ancestor. A child that already
+	// has another parent is reparented, which re-sorts on the next update
+	bool Attach(Registry& Scene, entt::entity Child, entt::entity Parent, Vector2 Local);
+	void Detach(Registry& Scene, entt::entity Child);
+
+	void SetLocal(Registry& Scene, entt::entity Child, Vector2 Local);
+
+	// re-sorts and relinks everything on the next update, for when the
+	// storage was written to behind the signals' back (rollback)
+	void Invalidate() { m_OrderDirty = true; }
+
+	// writes the world position of every child that moved into its transform,
+	// call before anything derives data from transforms
+	void Update(Registry& Scene);
+
+
+private:
+
+	void Rebuild(Registry& Scene);
+	void MarkAncestors(Registry& Scene, uint32_t Slot);
+
+	void OnConstruct(Registry& Scene, entt::entity Entity);
+	void OnUpdate(Registry& Scene, entt::entity Entity);
+	void OnDestroy(Registry& Scene, entt::entity Entity);
+
+
+private:
+
+	bool						m_OrderDirty;
+	std::vector<entt::entity>	m_Orphans;
+
+	// scratch for the sort, children by their parent's slot and the depth
+	// first rank of every node by entity index
+	std::vector<uint32_t>		m_ChildStart;
+	std::vector<uint32_t>		m_Children;
+	std::vector<uint32_t>		m_Stack;
+	std::vector<uint32_t>		m_Rank;
+
+};
@@ -1,30 +1,133 @@
 #pragma once
 
-struct Vector2
+#include "Fixed.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <type_traits>
+
+// header only so it inlines into every loop it's used in, and constexpr so
+// it works in constant expressions. Vector2 is all float, nothing goes
+// through double at run time, FixedVector2 is the same on Q16.16.
+
+namespace Math
 {
+	// sqrtf at run time, Newton's method when evaluated at compile time
+	constexpr float Sqrt(float Value)
+	{
+		if (std::is_constant_evaluated())
+		{
+			if (!(Value > 0.0f))
+				return 0.0f;
+
+			double Current	= Value < 1.0f ? 1.0 : double(Value);
+			double Previous	= 0.0;
+
+			for (int i = 0; i < 128 && Current != Previous; i++)
+			{
+				Previous	= Current;
+				Current		= 0.5 * (Current + double(Value) / Current);
+			}
+
+			return float(Current);
+		}
+
+		return std::sqrt(Value);
+	}
+
+	constexpr float Length(float x, float y) { return Sqrt(x * x + y * y); }
+
+	// smallest positive value, what a length is clamped to before dividing
+	template<typename Scalar>
+	constexpr Scalar Smallest();
+
+	template<>
+	constexpr float Smallest<float>() { return FLT_MIN; }
+
+	template<>
+	constexpr Fixed Smallest<Fixed>() { return Fixed::FromRaw(1); }
+}
+
+template<typename Scalar>
+struct BasicVector2
+{
+
+public:
+
+	Scalar	x;
+	Scalar	y;
+
+	constexpr BasicVector2(Scalar X = Scalar(), Scalar Y = Scalar())
+		: x(X)
+		, y(Y)
+	{
+
+	}
+
+	// between float and fixed point
+	template<typename Other>
+	constexpr explicit BasicVector2(const BasicVector2<Other>& From)
+		: x(Scalar(From.x))
+		, y(Scalar(From.y))
+	{
+
+	}
+
+	~BasicVector2() = default;
+
 
 public:
 
-	float	x;
-	float	y;
+	constexpr Scalar Dot(const BasicVector2& rhs)	const { return (x * rhs.x) + (y * rhs.y); }
+	constexpr Scalar MagnitudeSquared()				const { return Dot(*this); }
+	constexpr Scalar Magnitude()					const { return Math::Length(x, y); }
+
+	// a zero vector stays zero
+	constexpr BasicVector2 Normalize() const { return *this / Magnitude(); }
 
-	Vector2(float X = 0, float Y = 0);
-	~Vector2() = default;
+	// same as Normalize without the branch, the length is clamped away from
+	// zero instead which still leaves a zero vector zero
+	constexpr BasicVector2 NormalizeSafe() const
+	{
+		const Scalar Length = Magnitude();
+		const Scalar Scale = Scalar(1) / (Length > Math::Smallest<Scalar>() ? Length : Math::Smallest<Scalar>());
+
+		return BasicVector2(x * Scale, y * Scale);
+	}
 
 
 public:
-	
-	Vector2		Normalize()				const;
-	float		Magnitude()				const;
-	float		Dot(const Vector2& rhs) const;
+
+	constexpr BasicVector2 operator / (Scalar scalar) const
+	{
+		if (scalar != Scalar())	// non-zero check
+		{
+			return BasicVector2(x / scalar, y / scalar);
+		}
+
+		return *this;
+	}
+
+	constexpr BasicVector2	operator * (Scalar scalar)				const { return BasicVector2(x * scalar, y * scalar); }
+	constexpr BasicVector2	operator + (const BasicVector2& rhs)	const { return BasicVector2(x + rhs.x, y + rhs.y); }
+	constexpr BasicVector2	operator - (const BasicVector2& rhs)	const { return BasicVector2(x - rhs.x, y - rhs.y); }
+	constexpr BasicVector2	operator - ()							const { return BasicVector2(-x, -y); }
+	constexpr Scalar		operator * (const BasicVector2& rhs)	const { return Dot(rhs); }
+
+	constexpr bool operator == (const BasicVector2& rhs) const = default;
 
 
 public:
 
-	Vector2 operator / (float scalar);
-	Vector2 operator * (float scalar);
-	Vector2 operator + (const Vector2& rhs);
-	Vector2 operator - (const Vector2& rhs);
-	float	operator * (const Vector2& rhs);
+	constexpr BasicVector2& operator += (const BasicVector2& rhs)	{ x += rhs.x; y += rhs.y; return *this; }
+	constexpr BasicVector2& operator -= (const BasicVector2& rhs)	{ x -= rhs.x; y -= rhs.y; return *this; }
+	constexpr BasicVector2& operator *= (Scalar scalar)				{ x *= scalar; y *= scalar; return *this; }
+	constexpr BasicVector2& operator /= (Scalar scalar)				{ return *this = *this / scalar; }
+
+};
+
+template<typename Scalar>
+constexpr BasicVector2<Scalar> operator * (Scalar scalar, const BasicVector2<Scalar>& rhs) { return rhs * scalar; }
 
-};
\ No newline at end of file
+using Vector2		= BasicVector2<float>;
+using FixedVector2	= BasicVector2<Fixed>;
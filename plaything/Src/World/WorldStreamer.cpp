@@ -0,0 +1,395 @@
+#include "WorldStreamer.hpp"
+
+#include "../Systems/Groups.hpp"
+
+#include <SDL2/SDL_rwops.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <type_traits>
+
+namespace
+{
+	constexpr uint32_t ChunkMagic	= 0x4b434c50;	// "PLCK"
+	constexpr uint32_t ChunkVersion	= 3 | SimulationFormat;
+
+	// enemies are spawned this far inside the chunk's right and bottom edges
+	constexpr float EnemyExtent = 100.0f;
+
+	static_assert(std::is_trivially_copyable_v<TransformComponent> && std::is_trivially_copyable_v<VelocityComponent>, "Chunks store enemies as raw bytes");
+}
+
+
+WorldStreamer::WorldStreamer()
+	: m_Quit(false)
+{
+
+}
+
+
+WorldStreamer::~WorldStreamer()
+{
+	if (m_Worker.joinable())
+	{
+		{
+			std::lock_guard Lock(m_Mutex);
+			m_Quit = true;
+		}
+
+		m_RequestCondition.notify_one();
+		m_Worker.join();
+	}
+}
+
+
+bool WorldStreamer::Start(const std::string& Directory)
+{
+	if (m_Worker.joinable())
+		return true;
+
+	std::error_code Error;
+	std::filesystem::create_directories(Directory, Error);
+
+	if (Error)
+		return false;
+
+	m_Directory	= Directory;
+	m_Quit		= false;
+	m_Worker	= std::thread(&WorldStreamer::WorkerLoop, this);
+
+	return true;
+}
+
+
+void WorldStreamer::Stop(Registry& Scene)
+{
+	if (!m_Worker.joinable())
+		return;
+
+	// loads still in flight are dropped, their chunks were never changed
+	Unload(Scene, 0, 0, true);
+	m_Chunks.clear();
+
+	// queued saves are still written before the worker exits
+	{
+		std::lock_guard Lock(m_Mutex);
+		m_Quit = true;
+	}
+
+	m_RequestCondition.notify_one();
+	m_Worker.join();
+
+	m_Ready.clear();
+}
+
+
+bool WorldStreamer::Update(Registry& Scene, Vector2 Focus, const std::function<bool(const Chunk&)>& Commit)
+{
+	const int32_t FocusX = CellOf(Focus.x);
+	const int32_t FocusY = CellOf(Focus.y);
+
+	for (int32_t y = FocusY - LoadRadius; y <= FocusY + LoadRadius; y++)
+	{
+		for (int32_t x = FocusX - LoadRadius; x <= FocusX + LoadRadius; x++)
+		{
+			if (m_Chunks.contains(KeyOf(x, y)))
+				continue;
+
+			std::unique_ptr<Chunk> Data = Acquire();
+			Data->X = x;
+			Data->Y = y;
+
+			m_Chunks.emplace(KeyOf(x, y), ChunkState::Loading);
+			Enqueue(RequestKind::Load, std::move(Data));
+		}
+	}
+
+	bool Changed = Unload(Scene, FocusX, FocusY, false);
+
+	for (uint32_t i = 0; i < CommitBudget; i++)
+	{
+		std::unique_ptr<Chunk> Data;
+
+		{
+			std::lock_guard Lock(m_Mutex);
+
+			if (m_Ready.empty())
+				break;
+
+			Data = std::move(m_Ready.front());
+			m_Ready.pop_front();
+		}
+
+		// no room in the scene yet, it waits at the front
+		if (!Commit(*Data))
+		{
+			std::lock_guard Lock(m_Mutex);
+			m_Ready.push_front(std::move(Data));
+			break;
+		}
+
+		m_Chunks[KeyOf(Data->X, Data->Y)] = ChunkState::Loaded;
+		Changed = true;
+
+		Release(std::move(Data));
+	}
+
+	return Changed;
+}
+
+
+bool WorldStreamer::Read(const std::string& Path, Chunk& Into)
+{
+	SDL_RWops* File = SDL_RWFromFile(Path.c_str(), "rb");
+
+	if (!File)
+		return false;
+
+	uint32_t Header[3]{};
+	bool Valid = SDL_RWread(File, Header, sizeof(uint32_t), 3) == 3 && Header[0] == ChunkMagic && Header[1] == ChunkVersion;
+
+	// a truncated or corrupt count mustn't size the buffers
+	const int64_t Expected = int64_t(sizeof(Header)) + int64_t(Header[2]) * int64_t(sizeof(TransformComponent) + sizeof(VelocityComponent));
+
+	Valid = Valid && Header[2] <= ChunkCapacity && SDL_RWsize(File) == Expected;
+
+	if (Valid)
+	{
+		Into.Enemies.resize(Header[2], TransformComponent(0, 0));
+		Into.Velocities.resize(Header[2]);
+
+		Valid = SDL_RWread(File, Into.Enemies.data(), sizeof(TransformComponent), Header[2]) == Header[2];
+		Valid = Valid && SDL_RWread(File, Into.Velocities.data(), sizeof(VelocityComponent), Header[2]) == Header[2];
+	}
+
+	SDL_RWclose(File);
+
+	return Valid;
+}
+
+
+bool WorldStreamer::Write(const std::string& Path, const Chunk& From)
+{
+	SDL_RWops* File = SDL_RWFromFile(Path.c_str(), "wb");
+
+	if (!File)
+		return false;
+
+	const uint32_t Header[3] = { ChunkMagic, ChunkVersion, uint32_t(From.Enemies.size()) };
+
+	bool Written = SDL_RWwrite(File, Header, sizeof(uint32_t), 3) == 3;
+	Written = Written && SDL_RWwrite(File, From.Enemies.data(), sizeof(TransformComponent), From.Enemies.size()) == From.Enemies.size();
+	Written = Written && SDL_RWwrite(File, From.Velocities.data(), sizeof(VelocityComponent), From.Velocities.size()) == From.Velocities.size();
+
+	return SDL_RWclose(File) == 0 && Written;
+}
+
+
+void WorldStreamer::Generate(Chunk& Into)
+{
+	std::minstd_rand Random(uint32_t(Into.X) * 73856093u ^ uint32_t(Into.Y) * 19349663u ^ 0x5bd1e995u);
+
+	std::uniform_int_distribution<uint32_t>	Count(8, 32);
+	std::uniform_real_distribution<float>	Offset(0.0f, ChunkSize - EnemyExtent);
+
+	Into.Enemies.clear();
+	Into.Velocities.clear();
+
+	for (uint32_t i = Count(Random); i > 0; i--)
+	{
+		Into.Enemies.emplace_back(Into.X * ChunkSize + Offset(Random), Into.Y * ChunkSize + Offset(Random));
+		Into.Velocities.emplace_back();
+	}
+}
+
+
+std::string WorldStreamer::PathOf(int32_t x, int32_t y) const
+{
+	char Name[64]{};
+	snprintf(Name, sizeof(Name), "/chunk_%d_%d.bin", x, y);
+
+	return m_Directory + Name;
+}
+
+
+std::unique_ptr<WorldStreamer::Chunk> WorldStreamer::Acquire()
+{
+	{
+		std::lock_guard Lock(m_Mutex);
+
+		if (!m_Free.empty())
+		{
+			std::unique_ptr<Chunk> Data = std::move(m_Free.back());
+			m_Free.pop_back();
+
+			return Data;
+		}
+	}
+
+	return std::make_unique<Chunk>();
+}
+
+
+void WorldStreamer::Release(std::unique_ptr<Chunk> Data)
+{
+	// buffers keep their capacity, steady state streaming doesn't allocate
+	Data->Enemies.clear();
+	Data->Velocities.clear();
+
+	std::lock_guard Lock(m_Mutex);
+	m_Free.push_back(std::move(Data));
+}
+
+
+void WorldStreamer::Enqueue(RequestKind Kind, std::unique_ptr<Chunk> Data)
+{
+	{
+		std::lock_guard Lock(m_Mutex);
+		m_Requests.push_back(Request{ Kind, std::move(Data) });
+	}
+
+	m_RequestCondition.notify_one();
+}
+
+
+bool WorldStreamer::Unload(Registry& Scene, int32_t FocusX, int32_t FocusY, bool Everything)
+{
+	auto Outside = [&](int32_t x, int32_t y)
+	{
+		return Everything || std::max(std::abs(x - FocusX), std::abs(y - FocusY)) > UnloadRadius;
+	};
+
+	auto Staging = [this](int32_t x, int32_t y)
+	{
+		std::unique_ptr<Chunk> Data = Acquire();
+		Data->X = x;
+		Data->Y = y;
+
+		return Data;
+	};
+
+	m_Unloading.clear();
+
+	// loaded chunks out of range are written back whole, even with nobody left in them.
+	// A chunk still loading is unloaded once it's in
+	for (auto It = m_Chunks.begin(); It != m_Chunks.end(); )
+	{
+		const int32_t x = int32_t(It->first >> 32);
+		const int32_t y = int32_t(uint32_t(It->first));
+
+		if (It->second == ChunkState::Loaded && Outside(x, y))
+		{
+			m_Unloading.emplace(It->first, Request{ RequestKind::Save, Staging(x, y) });
+			It = m_Chunks.erase(It);
+		}
+		else
+		{
+			++It;
+		}
+	}
+
+	m_Doomed.clear();
+
+	// every enemy out of range goes, whichever chunk it wandered or was spawned into
+	for (auto [Entity, Transform, Quad, Collider] : Groups::Enemies(Scene).each())
+	{
+		const int32_t x = CellOf(float(Transform.m_Position.x));
+		const int32_t y = CellOf(float(Transform.m_Position.y));
+		const uint64_t Key = KeyOf(x, y);
+
+		if (!Outside(x, y) || m_Chunks.contains(Key))
+			continue;
+
+		auto It = m_Unloading.find(Key);
+
+		if (It == m_Unloading.end())
+			It = m_Unloading.emplace(Key, Request{ RequestKind::Merge, Staging(x, y) }).first;
+
+		Chunk& Into = *It->second.Data;
+
+		// past its capacity a crowd is dropped rather than written back
+		if (Into.Enemies.size() < ChunkCapacity)
+		{
+			// bounds are derived again once the chunk comes back
+			Into.Enemies.push_back(Transform);
+			Into.Enemies.back().m_Dirty = true;
+
+			Into.Velocities.push_back(Scene.get<VelocityComponent>(Entity));
+		}
+
+		m_Doomed.push_back(Entity);
+	}
+
+	// attachments follow on the next hierarchy update
+	Scene.destroy(m_Doomed.begin(), m_Doomed.end());
+
+	const bool Unloaded = !m_Unloading.empty();
+
+	for (auto [Key, Each] : m_Unloading)
+		Enqueue(Each.Kind, std::move(Each.Data));
+
+	m_Unloading.clear();
+
+	return Unloaded;
+}
+
+
+void WorldStreamer::WorkerLoop()
+{
+	while (true)
+	{
+		Request Next{};
+
+		{
+			std::unique_lock Lock(m_Mutex);
+			m_RequestCondition.wait(Lock, [this]() { return m_Quit || !m_Requests.empty(); });
+
+			if (m_Requests.empty())
+				return;
+
+			Next = std::move(m_Requests.front());
+			m_Requests.pop_front();
+		}
+
+		// requests run in order, a chunk saved and asked for again is read back after the write
+		const std::string Path = PathOf(Next.Data->X, Next.Data->Y);
+
+		if (Next.Kind == RequestKind::Save)
+		{
+			Write(Path, *Next.Data);
+			Release(std::move(Next.Data));
+			continue;
+		}
+
+		// on top of what the file holds, or what the chunk would have been generated with
+		if (Next.Kind == RequestKind::Merge)
+		{
+			std::unique_ptr<Chunk> Merged = Acquire();
+			Merged->X = Next.Data->X;
+			Merged->Y = Next.Data->Y;
+
+			if (!Read(Path, *Merged))
+				Generate(*Merged);
+
+			const size_t Count = std::min(Next.Data->Enemies.size(), ChunkCapacity - std::min<size_t>(Merged->Enemies.size(), ChunkCapacity));
+
+			Merged->Enemies.insert(Merged->Enemies.end(), Next.Data->Enemies.begin(), Next.Data->Enemies.begin() + Count);
+			Merged->Velocities.insert(Merged->Velocities.end(), Next.Data->Velocities.begin(), Next.Data->Velocities.begin() + Count);
+
+			Write(Path, *Merged);
+
+			Release(std::move(Merged));
+			Release(std::move(Next.Data));
+			continue;
+		}
+
+		if (!Read(Path, *Next.Data))
+			Generate(*Next.Data);
+
+		std::lock_guard Lock(m_Mutex);
+		m_Ready.push_back(std::move(Next.Data));
+	}
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../Components/TransformComponent.hpp"
+#include "../Components/VelocityComponent.hpp"
+#include "../Registry.hpp"
+#include "../Vector2.hpp"
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// the world as a grid of chunks streamed in and out around a focus point.
+// A worker thread reads chunk files (or generates chunks that were never
+// visited) into pooled staging buffers. The main thread commits finished
+// chunks into the scene in bulk at a frame boundary, at most CommitBudget
+// per frame and only as long as Commit takes them, and hands chunks that
+// fell out of range back to the worker to be written out after destroying
+// their entities. Enemies that wandered off into a chunk that isn't loaded
+// are added to that chunk's file the same way. Only the chunks within
+// UnloadRadius of the focus are ever in memory, however big the world is,
+// and no chunk holds more than ChunkCapacity enemies.
+//
+// What a chunk holds are its enemies, by position, and how they were
+// moving. Level geometry isn't streamed.
+
+class WorldStreamer
+{
+
+public:
+
+	static constexpr float		ChunkSize		= 1024.0f;
+	static constexpr int32_t	LoadRadius		= 1;	// chunks, in every direction
+	static constexpr int32_t	UnloadRadius	= 2;	// kept loaded a ring further so walking a border doesn't thrash
+	static constexpr uint32_t	CommitBudget	= 2;	// chunks committed per frame
+	static constexpr uint32_t	ChunkCapacity	= 512;	// enemies a chunk holds at most
+
+
+public:
+
+	// staging buffer for one chunk, pooled
+	struct Chunk
+	{
+		int32_t							X = 0;
+		int32_t							Y = 0;
+		std::vector<TransformComponent>	Enemies;
+		std::vector<VelocityComponent>	Velocities;	// one per enemy
+	};
+
+
+public:
+
+	WorldStreamer();
+	~WorldStreamer();
+
+	WorldStreamer(const WorldStreamer&) = delete;
+	WorldStreamer& operator = (const WorldStreamer&) = delete;
+
+
+public:
+
+	// chunk files go into Directory, created if missing
+	bool Start(const std::string& Directory);
+
+	// writes every loaded chunk out and waits for the worker to finish
+	void Stop(Registry& Scene);
+
+	bool Enabled() const { return m_Worker.joinable(); }
+
+	// requests the chunks around Focus, unloads distant ones and commits
+	// chunks the worker finished through Commit. A chunk Commit returns
+	// false for is offered again next frame. Call at a frame boundary,
+	// true if any chunk came into or left the scene
+	bool Update(Registry& Scene, Vector2 Focus, const std::function<bool(const Chunk&)>& Commit);
+
+
+public:
+
+	static bool Read(const std::string& Path, Chunk& Into);
+	static bool Write(const std::string& Path, const Chunk& From);
+
+	// what a chunk holds the first time it's visited, same for every run
+	static void Generate(Chunk& Into);
+
+
+private:
+
+	enum class ChunkState
+	{
+		Loading,
+		Loaded,
+	};
+
+	enum class RequestKind
+	{
+		Load,
+		Save,	// the whole chunk, replacing its file
+		Merge,	// added to what the chunk's file holds
+	};
+
+	struct Request
+	{
+		RequestKind				Kind;
+		std::unique_ptr<Chunk>	Data;
+	};
+
+
+private:
+
+	static uint64_t KeyOf(int32_t x, int32_t y) { return (uint64_t(uint32_t(x)) << 32) | uint32_t(y); }
+	static int32_t	CellOf(float Position) { return int32_t(std::floor(Position / ChunkSize)); }
+
+	std::string				PathOf(int32_t x, int32_t y) const;
+	std::unique_ptr<Chunk>	Acquire();
+	void					Release(std::unique_ptr<Chunk> Data);
+	void					Enqueue(RequestKind Kind, std::unique_ptr<Chunk> Data);
+
+	// everything further than UnloadRadius from the focus cell, or everything at all
+	bool Unload(Registry& Scene, int32_t FocusX, int32_t FocusY, bool Everything);
+	void WorkerLoop();
+
+
+private:
+
+	std::string		m_Directory;
+
+	// main thread only
+	entt::dense_map<uint64_t, ChunkState>	m_Chunks;
+	std::vector<entt::entity>				m_Doomed;
+	entt::dense_map<uint64_t, Request>		m_Unloading;
+
+	// shared with the worker
+	std::deque<Request>						m_Requests;
+	std::deque<std::unique_ptr<Chunk>>		m_Ready;
+	std::vector<std::unique_ptr<Chunk>>		m_Free;
+
+	std::mutex					m_Mutex;
+	std::condition_variable		m_RequestCondition;
+
+	std::thread					m_Worker;
+	bool						m_Quit;
+
+};
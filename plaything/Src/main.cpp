@@ -2,7 +2,7 @@
 
 int main(int argc, char* argv[])
 {
-	Application This{};
+	Application This{ argc, argv };
 
 	return This.OnExecute();
 }